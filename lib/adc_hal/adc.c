@@ -0,0 +1,226 @@
+// ADC engine internals:
+//   1) Channel rotation:
+//      - ADMUX is latched when a conversion starts. Triggered: nothing is running while
+//        ADC_vect executes, so the MUX written there is used by the next trigger.
+//      - Free running: the next conversion has already started (with the MUX written one
+//        ISR earlier) when ADC_vect runs, so the result is one channel behind the MUX:
+//        adc_cur = channel of the result, adc_next = channel already converting.
+//
+//   2) Trigger flags:
+//      - A conversion starts on the rising edge of the trigger's interrupt flag. Timer0 OVF
+//        is cleared by the timebase ISR; the other sources have no ISR here, so ADC_vect
+//        clears their flag to re-arm the trigger.
+//
+//   3) Ring:
+//      - SPSC, free-running 8-bit indices (as the UART rings): ADC_vect writes the sample,
+//        _MemoryBarrier(), then publishes head; adc_read() copies out, then advances tail.
+
+#include "adc.h"
+#include "timebase.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/cpufunc.h>
+
+#if (ADC_RING_SIZE < 2) || (ADC_RING_SIZE > 128) || (ADC_RING_SIZE & (ADC_RING_SIZE - 1))
+#error "ADC_RING_SIZE must be a power of two in 2..128"
+#endif
+
+#define ADC_RING_MASK (ADC_RING_SIZE - 1)
+
+static adc_sample_t adc_ring[ADC_RING_SIZE];
+static volatile uint8_t adc_head;       // written by ISR
+static volatile uint8_t adc_tail;       // written by main
+static volatile uint8_t adc_lost;       // written by ISR
+
+// Engine setup (written only while stopped)
+static uint8_t adc_mask;
+static uint8_t adc_admux_ref;           // REFS1:0 bits of ADMUX
+static uint8_t adc_trig;
+static uint8_t adc_os_bits;
+static volatile uint8_t *adc_trig_flag; // flag register to re-arm, or NULL
+static uint8_t adc_trig_bit;
+static uint8_t adc_didr_saved;
+
+// ISR state
+static uint8_t adc_cur;
+static uint8_t adc_next;
+static uint16_t adc_acc[8];
+static uint8_t adc_cnt[8];
+
+// Next enabled channel after ch (cyclic)
+static inline uint8_t adc_advance(uint8_t ch)
+{
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        ch = (uint8_t)((ch + 1) & 7);
+        if (adc_mask & (1 << ch))
+            return ch;
+    }
+    return ch;
+}
+
+static inline void adc_push(uint8_t ch, uint16_t value)
+{
+    uint8_t head = adc_head;
+    if ((uint8_t)(head - adc_tail) >= ADC_RING_SIZE)
+    {
+        adc_lost++;
+        return;
+    }
+    adc_sample_t *s = &adc_ring[head & ADC_RING_MASK];
+    s->t_us = time_us();
+    s->value = value;
+    s->channel = ch;
+    _MemoryBarrier(); // sample before the index that publishes it
+    adc_head = head + 1;
+}
+
+ISR(ADC_vect)
+{
+    uint16_t v = ADC; // ADCL then ADCH
+    uint8_t ch = adc_cur;
+
+    if (adc_trig == ADC_TRIG_FREE_RUN)
+    {
+        adc_cur = adc_next;             // converting now
+        adc_next = adc_advance(adc_next);
+        ADMUX = (uint8_t)(adc_admux_ref | adc_next);
+    }
+    else
+    {
+        adc_cur = adc_advance(adc_cur);
+        ADMUX = (uint8_t)(adc_admux_ref | adc_cur);
+        if (adc_trig_flag)
+            *adc_trig_flag = adc_trig_bit; // write 1 to clear: next edge can trigger
+    }
+
+    if (adc_os_bits == 0)
+    {
+        adc_push(ch, v);
+        return;
+    }
+
+    // Oversampling: 4^n conversions summed, >> n (at most 64 * 1023, fits 16 bits)
+    uint16_t acc = (uint16_t)(adc_acc[ch] + v);
+    uint8_t cnt = (uint8_t)(adc_cnt[ch] + 1);
+    if (cnt >= (uint8_t)(1 << (2 * adc_os_bits)))
+    {
+        adc_push(ch, (uint16_t)(acc >> adc_os_bits));
+        acc = 0;
+        cnt = 0;
+    }
+    adc_acc[ch] = acc;
+    adc_cnt[ch] = cnt;
+}
+
+adc_status_t adc_init(const adc_config_t *cfg)
+{
+    if (!cfg || !cfg->channels || cfg->oversample_bits > 3 ||
+        cfg->clkdiv < ADC_CLK_DIV16 || cfg->clkdiv > ADC_CLK_DIV128)
+        return ADC_ERR_PARAM;
+    if (ADCSRA & (1 << ADATE))
+        return ADC_ERR_BUSY;
+
+    volatile uint8_t *flag = 0;
+    uint8_t bit = 0;
+    switch (cfg->trigger)
+    {
+    case ADC_TRIG_FREE_RUN:
+    case ADC_TRIG_TIMER0_OVF:
+        break;
+    case ADC_TRIG_TIMER0_COMPA: flag = &TIFR0; bit = (1 << OCF0A); break;
+    case ADC_TRIG_TIMER1_COMPB: flag = &TIFR1; bit = (1 << OCF1B); break;
+    case ADC_TRIG_TIMER1_OVF:   flag = &TIFR1; bit = (1 << TOV1);  break;
+    case ADC_TRIG_TIMER1_CAPT:  flag = &TIFR1; bit = (1 << ICF1);  break;
+    default:
+        return ADC_ERR_PARAM;
+    }
+
+    timebase_init(); // sample timestamps (and the Timer0 triggers)
+    PRR &= (uint8_t)~(1 << PRADC);
+
+    adc_mask = cfg->channels;
+    adc_admux_ref = (uint8_t)(cfg->ref << REFS0);
+    adc_trig = cfg->trigger;
+    adc_trig_flag = flag;
+    adc_trig_bit = bit;
+    adc_os_bits = cfg->oversample_bits;
+    adc_head = adc_tail = 0;
+    adc_lost = 0;
+
+    // Analog-only pins: digital input buffers off (ADC6/7 have none)
+    adc_didr_saved = DIDR0;
+    DIDR0 = (uint8_t)(adc_didr_saved | (adc_mask & 0x3F));
+
+    ADCSRA = (uint8_t)((1 << ADEN) | cfg->clkdiv);
+    ADCSRB = cfg->trigger;
+    return ADC_OK;
+}
+
+adc_status_t adc_start(void)
+{
+    if (!adc_mask)
+        return ADC_ERR_PARAM;
+    if (ADCSRA & (1 << ADATE))
+        return ADC_ERR_BUSY;
+
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        adc_acc[i] = 0;
+        adc_cnt[i] = 0;
+    }
+    // First enabled channel (adc_advance from 7 wraps to the lowest one)
+    adc_cur = adc_next = adc_advance(7);
+    ADMUX = (uint8_t)(adc_admux_ref | adc_cur);
+
+    if (adc_trig_flag)
+        *adc_trig_flag = adc_trig_bit; // a stale flag would never give a rising edge
+
+    uint8_t a = (uint8_t)((ADCSRA & 0x07) | (1 << ADEN) | (1 << ADATE) | (1 << ADIE) | (1 << ADIF));
+    if (adc_trig == ADC_TRIG_FREE_RUN)
+        a |= (1 << ADSC); // first conversion by hand, the rest follow on their own
+    ADCSRA = a;
+    return ADC_OK;
+}
+
+void adc_stop(void)
+{
+    // Auto trigger and interrupt off; a conversion in flight finishes unreported
+    ADCSRA &= (uint8_t)~((1 << ADATE) | (1 << ADIE));
+}
+
+void adc_deinit(void)
+{
+    adc_stop();
+    ADCSRA = 0;
+    DIDR0 = adc_didr_saved;
+    adc_mask = 0;
+    PRR |= (1 << PRADC);
+}
+
+uint8_t adc_read(adc_sample_t *buf, uint8_t max)
+{
+    if (!buf)
+        return 0;
+
+    uint8_t tail = adc_tail;
+    uint8_t n = 0;
+    while (n < max && adc_head != tail)
+    {
+        _MemoryBarrier();
+        buf[n++] = adc_ring[tail & ADC_RING_MASK];
+        tail++;
+        adc_tail = tail; // slot free once copied
+    }
+    return n;
+}
+
+uint8_t adc_available(void)
+{
+    return (uint8_t)(adc_head - adc_tail);
+}
+
+uint8_t adc_overruns(void)
+{
+    return adc_lost;
+}
@@ -0,0 +1,74 @@
+#ifndef ADC_HAL_H
+#define ADC_HAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "gpio.h"
+
+// Background ADC sampling engine.
+// Conversions run back to back (free running) or on a timer event (ADTS);
+// ADC_vect rotates through the enabled channels and pushes timestamped
+// samples into a lock-free ring, which the application drains in batches.
+// One conversion takes 13 ADC clocks: 104 us at clk/128 (125 kHz @16 MHz).
+//
+// Channels: bit n of adc_config_t.channels = ADCn (A0..A5 = 0..5; 6/7 only on
+// TQFP/QFN parts). Their digital input buffers are turned off (DIDR0) while
+// the engine owns them, so gpio_read() on those pins returns 0.
+
+#ifndef ADC_RING_SIZE
+#define ADC_RING_SIZE 16        // samples, power of two in 2..128
+#endif
+
+typedef enum {
+    ADC_OK = 0,
+    ADC_ERR_PARAM,
+    ADC_ERR_BUSY                // engine running
+} adc_status_t;
+
+typedef enum {
+    ADC_REF_AREF = 0,           // external AREF pin
+    ADC_REF_AVCC = 1,           // AVCC, cap on AREF
+    ADC_REF_1V1  = 3            // internal 1.1 V
+} adc_ref_t;
+
+// ADTS2:0 (auto trigger source)
+typedef enum {
+    ADC_TRIG_FREE_RUN     = 0,  // back to back, fastest
+    ADC_TRIG_TIMER0_COMPA = 3,
+    ADC_TRIG_TIMER0_OVF   = 4,  // timebase overflow: one conversion per 1.024 ms
+    ADC_TRIG_TIMER1_COMPB = 5,
+    ADC_TRIG_TIMER1_OVF   = 6,
+    ADC_TRIG_TIMER1_CAPT  = 7
+} adc_trigger_t;
+
+typedef enum {
+    ADC_CLK_DIV16 = 4,          // 1 MHz: fast, ~8-bit accuracy
+    ADC_CLK_DIV32 = 5,
+    ADC_CLK_DIV64 = 6,
+    ADC_CLK_DIV128 = 7          // 125 kHz: full 10-bit accuracy @16 MHz
+} adc_clkdiv_t;
+
+typedef struct {
+    uint8_t channels;           // bitmask, at least one
+    adc_ref_t ref;
+    adc_trigger_t trigger;
+    adc_clkdiv_t clkdiv;
+    uint8_t oversample_bits;    // 0..3: sum 4^n conversions per sample, >> n (10 + n bits)
+} adc_config_t;
+
+typedef struct {
+    uint32_t t_us;              // time_us() when the (last) conversion completed
+    uint16_t value;             // 10 + oversample_bits bits
+    uint8_t channel;
+} adc_sample_t;
+
+adc_status_t adc_init(const adc_config_t *cfg);   // configures, does not start
+adc_status_t adc_start(void);
+void         adc_stop(void);                      // finishes nothing, drops partial sums
+void         adc_deinit(void);                    // stop, restore DIDR0, gate the ADC via PRR
+
+uint8_t adc_read(adc_sample_t *buf, uint8_t max); // non-blocking batch, returns the count
+uint8_t adc_available(void);
+uint8_t adc_overruns(void);                       // samples lost to a full ring since init (wraps)
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "gpio.h"
+
+// Whole-port debouncer on the Timer0 timebase tick.
+// Every DEBOUNCE_TICK_DIV overflows each enabled port is sampled with one PINx
+// read and run through a 2-bit vertical counter (one counter bit-plane per
+// byte, 8 pins in parallel): a pin changes its debounced state only after
+// 4 consecutive samples disagree with it, i.e. ~16 ms at the default 4 ms.
+// Press/release edges accumulate per port until read (and cleared).
+
+#ifndef DEBOUNCE_TICK_DIV
+#define DEBOUNCE_TICK_DIV 4     // timebase overflows (1.024 ms @16 MHz) per sample
+#endif
+
+// mask: pins of this port to debounce (PORTB bit 0 = D8, PORTC bit 0 = A0, PORTD bit 0 = D0)
+// active_low: pins that read 0 when active (button to GND with pull-up)
+// Pin modes are left to the application (gpio_pin_mode / gpio_group_mode).
+bool debounce_init(void);       // hooks the timebase; false if no hook slot is free
+void debounce_enable(gpio_port_t port, uint8_t mask, uint8_t active_low);
+
+uint8_t debounce_state(gpio_port_t port);     // debounced "active" bits
+uint8_t debounce_pressed(gpio_port_t port);   // became active since last call (clears)
+uint8_t debounce_released(gpio_port_t port);  // became inactive since last call (clears)
+
+// Sample all ports now (called by the timebase hook; usable from another timer)
+void debounce_tick(void);
+
+#endif
@@ -65,11 +65,14 @@ bool gpio_write(gpio_pin_t pin, gpio_level_t level) {
     if (pin >= GPIO_PIN_COUNT) return false;
 
     const gpio_map_t *p = &gpio_map[pin];
+    uint8_t sreg = SREG;
+    cli(); // PORTx RMW: an ISR writing another pin of the port (RS-485 DE) must not be undone
     if (level == GPIO_HIGH) {
         *(p->port) |= p->mask;
     } else {
         *(p->port) &= ~(p->mask);
     }
+    SREG = sreg;
     return true;
 }
 
@@ -90,4 +93,161 @@ bool gpio_toggle(gpio_pin_t pin) {
     *(p->pin) = p->mask; 
     SREG = sreg;
     return true;
-}
\ No newline at end of file
+}
+// ----------------------------- Pin groups -----------------------------
+typedef struct {
+    volatile uint8_t* ddr;
+    volatile uint8_t* port;
+    volatile uint8_t* pin;
+} gpio_port_map_t;
+
+/* Indexed by gpio_port_t */
+static const gpio_port_map_t gpio_ports[GPIO_PORT_COUNT] = {
+    { &DDRB, &PORTB, &PINB }, // GPIO_PORT_B
+    { &DDRC, &PORTC, &PINC }, // GPIO_PORT_C
+    { &DDRD, &PORTD, &PIND }  // GPIO_PORT_D
+};
+
+bool gpio_group_init(gpio_group_t *g, const gpio_pin_t *pins, uint8_t count) {
+    if (!g || !pins || count == 0 || count > GPIO_GROUP_MAX_PINS) return false;
+
+    for (uint8_t p = 0; p < GPIO_PORT_COUNT; p++) {
+        g->mask[p] = 0;
+        g->shift[p] = 0;
+    }
+    g->linear = 0;
+    g->count = count;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (pins[i] >= GPIO_PIN_COUNT) return false;
+        const gpio_map_t *m = &gpio_map[pins[i]];
+
+        // Find the port this pin lives on (reuses the pin map)
+        uint8_t p = 0;
+        while (gpio_ports[p].port != m->port) p++;
+        if (g->mask[p] & m->mask) return false; // duplicate pin
+
+        uint8_t bit = 0;
+        while (!(m->mask & (1 << bit))) bit++;
+        int8_t shift = (int8_t)(bit - i);
+
+        // A port stays "linear" while all its pins share one value->port shift
+        if (g->mask[p] == 0) {
+            g->shift[p] = shift;
+            g->linear |= (uint8_t)(1 << p);
+        } else if (g->shift[p] != shift) {
+            g->linear &= (uint8_t)~(1 << p);
+        }
+
+        g->mask[p] |= m->mask;
+        g->bit_port[i] = p;
+        g->bit_mask[i] = m->mask;
+    }
+    return true;
+}
+
+// value bits -> per-port output bits (no register access)
+static void gpio_group_spread(const gpio_group_t *g, uint8_t value, uint8_t *bits) {
+    for (uint8_t p = 0; p < GPIO_PORT_COUNT; p++) {
+        bits[p] = 0;
+        if (g->linear & (1 << p)) {
+            int8_t s = g->shift[p];
+            uint8_t v = (s >= 0) ? (uint8_t)(value << s) : (uint8_t)(value >> -s);
+            bits[p] = v & g->mask[p];
+        }
+    }
+    for (uint8_t i = 0; i < g->count; i++) {
+        uint8_t p = g->bit_port[i];
+        if (!(g->linear & (1 << p)) && (value & (1 << i))) {
+            bits[p] |= g->bit_mask[i];
+        }
+    }
+}
+
+void gpio_group_mode(const gpio_group_t *g, gpio_mode_t mode) {
+    if (!g) return;
+
+    uint8_t sreg = SREG;
+    cli();
+    for (uint8_t p = 0; p < GPIO_PORT_COUNT; p++) {
+        uint8_t m = g->mask[p];
+        if (!m) continue;
+        const gpio_port_map_t *r = &gpio_ports[p];
+        if (mode == GPIO_OUTPUT) {
+            *(r->ddr) |= m;
+        } else {
+            *(r->ddr) &= (uint8_t)~m;
+            if (mode == GPIO_INPUT_PULLUP) {
+                *(r->port) |= m;
+            } else {
+                *(r->port) &= (uint8_t)~m;
+            }
+        }
+    }
+    SREG = sreg;
+}
+
+void gpio_group_set(const gpio_group_t *g) {
+    if (!g) return;
+
+    uint8_t sreg = SREG;
+    cli();
+    for (uint8_t p = 0; p < GPIO_PORT_COUNT; p++) {
+        if (g->mask[p]) *(gpio_ports[p].port) |= g->mask[p];
+    }
+    SREG = sreg;
+}
+
+void gpio_group_clear(const gpio_group_t *g) {
+    if (!g) return;
+
+    uint8_t sreg = SREG;
+    cli();
+    for (uint8_t p = 0; p < GPIO_PORT_COUNT; p++) {
+        if (g->mask[p]) *(gpio_ports[p].port) &= (uint8_t)~g->mask[p];
+    }
+    SREG = sreg;
+}
+
+void gpio_group_write(const gpio_group_t *g, uint8_t value) {
+    if (!g) return;
+
+    // Work out every port value first so the critical section is only the stores
+    uint8_t bits[GPIO_PORT_COUNT];
+    gpio_group_spread(g, value, bits);
+
+    uint8_t sreg = SREG;
+    cli();
+    for (uint8_t p = 0; p < GPIO_PORT_COUNT; p++) {
+        uint8_t m = g->mask[p];
+        if (!m) continue;
+        volatile uint8_t *port = gpio_ports[p].port;
+        *port = (uint8_t)((*port & ~m) | bits[p]); // one store per port
+    }
+    SREG = sreg;
+}
+
+uint8_t gpio_group_read(const gpio_group_t *g) {
+    if (!g) return 0;
+
+    // Sample each PINx once, back to back
+    uint8_t in[GPIO_PORT_COUNT];
+    for (uint8_t p = 0; p < GPIO_PORT_COUNT; p++) {
+        in[p] = g->mask[p] ? (uint8_t)(*(gpio_ports[p].pin) & g->mask[p]) : 0;
+    }
+
+    uint8_t value = 0;
+    for (uint8_t p = 0; p < GPIO_PORT_COUNT; p++) {
+        if (g->linear & (1 << p)) {
+            int8_t s = g->shift[p];
+            value |= (s >= 0) ? (uint8_t)(in[p] >> s) : (uint8_t)(in[p] << -s);
+        }
+    }
+    for (uint8_t i = 0; i < g->count; i++) {
+        uint8_t p = g->bit_port[i];
+        if (!(g->linear & (1 << p)) && (in[p] & g->bit_mask[i])) {
+            value |= (uint8_t)(1 << i);
+        }
+    }
+    return value;
+}
@@ -26,12 +26,43 @@ enum {
     PIN_A0 = 14, PIN_A1,  PIN_A2,  PIN_A3,  PIN_A4,  PIN_A5
 };
 
-/* Public API */
+/* Ports behind the pin map: D8-D13 = B, A0-A5 = C, D0-D7 = D */
+typedef enum {
+    GPIO_PORT_B = 0,
+    GPIO_PORT_C,
+    GPIO_PORT_D,
+    GPIO_PORT_COUNT
+} gpio_port_t;
+
+/* Pin group: pins[i] <-> bit i of the value, up to 8 pins on any ports.
+ * Built once by gpio_group_init(); every operation then touches each
+ * involved port register exactly once, with interrupts held off so the
+ * pins of one port change together. */
+#define GPIO_GROUP_MAX_PINS 8
+
+typedef struct {
+    uint8_t mask[GPIO_PORT_COUNT];     // group pins on each port
+    int8_t  shift[GPIO_PORT_COUNT];    // port bit = value bit + shift (linear ports)
+    uint8_t linear;                    // bit p set: port p maps by a plain shift
+    uint8_t count;
+    uint8_t bit_port[GPIO_GROUP_MAX_PINS]; // value bit i -> port
+    uint8_t bit_mask[GPIO_GROUP_MAX_PINS]; // value bit i -> port bit mask
+} gpio_group_t;
+
+/* Public API (runtime pin; see gpio_fast.h for constant pins) */
 bool gpio_pin_mode(gpio_pin_t pin, gpio_mode_t mode);
 bool gpio_write(gpio_pin_t pin, gpio_level_t level);
 int8_t gpio_read(gpio_pin_t pin);      // return 0/1, or -1 if invalid pin
 bool gpio_toggle(gpio_pin_t pin);
 
+/* Pin groups */
+bool gpio_group_init(gpio_group_t *g, const gpio_pin_t *pins, uint8_t count); // false on bad/duplicate pin
+void gpio_group_mode(const gpio_group_t *g, gpio_mode_t mode);
+void gpio_group_set(const gpio_group_t *g);               // all pins high
+void gpio_group_clear(const gpio_group_t *g);             // all pins low
+void gpio_group_write(const gpio_group_t *g, uint8_t value);
+uint8_t gpio_group_read(const gpio_group_t *g);
+
 
 #endif
 
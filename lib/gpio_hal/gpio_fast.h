@@ -0,0 +1,81 @@
+#ifndef GPIO_FAST_H
+#define GPIO_FAST_H
+#include "gpio.h"
+
+// Compile-time pin API (header only).
+// For a constant PIN_Dx/PIN_Ax every call folds to one instruction:
+//   gpio_fast_high/low/write -> SBI/CBI PORTx
+//   gpio_fast_toggle         -> OUT PINx (writing 1 to PINxn toggles PORTxn)
+//   gpio_fast_read           -> SBIS/SBIC PINx (or IN + mask)
+// SBI/CBI/OUT are single instructions, so no SREG save/cli() is needed.
+// Use the runtime API in gpio.h when the pin is only known at run time.
+// Requires optimization (-Os/-O2/-Og, the PlatformIO default).
+
+// Same numbering as gpio_map[]: D0-D7 = PORTD, D8-D13 = PORTB, A0-A5 = PORTC
+#define GPIO_FAST_DDR(pin)  (*((pin) < 8 ? &DDRD  : (pin) < 14 ? &DDRB  : &DDRC))
+#define GPIO_FAST_PORT(pin) (*((pin) < 8 ? &PORTD : (pin) < 14 ? &PORTB : &PORTC))
+#define GPIO_FAST_PIN(pin)  (*((pin) < 8 ? &PIND  : (pin) < 14 ? &PINB  : &PINC))
+#define GPIO_FAST_BIT(pin)  ((pin) < 8 ? (pin) : (pin) < 14 ? (pin) - 8 : (pin) - 14)
+#define GPIO_FAST_MASK(pin) ((uint8_t)(1 << GPIO_FAST_BIT(pin)))
+
+// Fails the build if a call survives with a non-constant or out-of-range pin
+extern void gpio_fast_bad_pin(void)
+    __attribute__((error("gpio_fast_*: pin must be a constant PIN_Dx/PIN_Ax")));
+
+#define GPIO_FAST_INLINE static inline __attribute__((always_inline))
+
+GPIO_FAST_INLINE void gpio_fast_check(gpio_pin_t pin)
+{
+    if (!__builtin_constant_p(pin) || pin > PIN_A5)
+        gpio_fast_bad_pin();
+}
+
+GPIO_FAST_INLINE void gpio_fast_mode(gpio_pin_t pin, gpio_mode_t mode)
+{
+    gpio_fast_check(pin);
+    if (mode == GPIO_OUTPUT) {
+        GPIO_FAST_DDR(pin) |= GPIO_FAST_MASK(pin);
+    } else {
+        GPIO_FAST_DDR(pin) &= (uint8_t)~GPIO_FAST_MASK(pin);
+        if (mode == GPIO_INPUT_PULLUP) {
+            GPIO_FAST_PORT(pin) |= GPIO_FAST_MASK(pin);
+        } else {
+            GPIO_FAST_PORT(pin) &= (uint8_t)~GPIO_FAST_MASK(pin);
+        }
+    }
+}
+
+GPIO_FAST_INLINE void gpio_fast_high(gpio_pin_t pin)
+{
+    gpio_fast_check(pin);
+    GPIO_FAST_PORT(pin) |= GPIO_FAST_MASK(pin);
+}
+
+GPIO_FAST_INLINE void gpio_fast_low(gpio_pin_t pin)
+{
+    gpio_fast_check(pin);
+    GPIO_FAST_PORT(pin) &= (uint8_t)~GPIO_FAST_MASK(pin);
+}
+
+GPIO_FAST_INLINE void gpio_fast_write(gpio_pin_t pin, gpio_level_t level)
+{
+    if (level == GPIO_HIGH) {
+        gpio_fast_high(pin);
+    } else {
+        gpio_fast_low(pin);
+    }
+}
+
+GPIO_FAST_INLINE void gpio_fast_toggle(gpio_pin_t pin)
+{
+    gpio_fast_check(pin);
+    GPIO_FAST_PIN(pin) = GPIO_FAST_MASK(pin);
+}
+
+GPIO_FAST_INLINE gpio_level_t gpio_fast_read(gpio_pin_t pin)
+{
+    gpio_fast_check(pin);
+    return (GPIO_FAST_PIN(pin) & GPIO_FAST_MASK(pin)) ? GPIO_HIGH : GPIO_LOW;
+}
+
+#endif
@@ -0,0 +1,127 @@
+#include "gpio_irq.h"
+#include "gpio_fast.h"
+#include <avr/interrupt.h>
+
+/* Dispatch table indexed by gpio_pin_t (same numbering as gpio_map[]) */
+static gpio_irq_cb_t gpio_irq_cb[PIN_A5 + 1];
+
+/* PCINT banks share the gpio_port_t order: bank 0 = PORTB, 1 = PORTC, 2 = PORTD */
+typedef struct {
+    volatile uint8_t *pcmsk;
+    volatile uint8_t *pin;
+    gpio_pin_t first;                  // pin number of bit 0
+} gpio_pcint_map_t;
+
+static const gpio_pcint_map_t gpio_pcint[GPIO_PORT_COUNT] = {
+    { &PCMSK0, &PINB, PIN_D8 },
+    { &PCMSK1, &PINC, PIN_A0 },
+    { &PCMSK2, &PIND, PIN_D0 },
+};
+
+static uint8_t pcint_last[GPIO_PORT_COUNT];   // PINx at the previous interrupt
+static uint8_t pcint_rise[GPIO_PORT_COUNT];   // bits reporting 0 -> 1
+static uint8_t pcint_fall[GPIO_PORT_COUNT];   // bits reporting 1 -> 0
+
+static inline uint8_t gpio_pcint_bank(gpio_pin_t pin) {
+    return pin < 8 ? GPIO_PORT_D : pin < 14 ? GPIO_PORT_B : GPIO_PORT_C;
+}
+
+bool gpio_attach_interrupt(gpio_pin_t pin, gpio_edge_t edge, gpio_irq_cb_t cb) {
+    if (pin > PIN_A5 || edge > GPIO_LEVEL_LOW) return false;
+
+    uint8_t sreg = SREG;
+    cli();
+    gpio_irq_cb[pin] = cb;
+
+    if (pin == PIN_D2 || pin == PIN_D3) {
+        // ISCn1:ISCn0 = 00 low level, 01 any change, 10 falling, 11 rising
+        static const uint8_t isc[] = { 0x01, 0x02, 0x03, 0x00 };
+        uint8_t n = (uint8_t)(pin - PIN_D2);
+        uint8_t shift = (uint8_t)(n * 2);
+
+        EIMSK &= (uint8_t)~(1 << n);
+        EICRA = (uint8_t)((EICRA & ~(0x03 << shift)) | (isc[edge] << shift));
+        EIFR = (uint8_t)(1 << n);      // drop an edge latched while reconfiguring
+        EIMSK |= (uint8_t)(1 << n);
+    } else {
+        if (edge == GPIO_LEVEL_LOW) {
+            SREG = sreg;
+            return false;
+        }
+        uint8_t bank = gpio_pcint_bank(pin);
+        uint8_t mask = GPIO_FAST_MASK(pin);
+        const gpio_pcint_map_t *m = &gpio_pcint[bank];
+
+        pcint_rise[bank] = (edge != GPIO_EDGE_FALLING) ? (pcint_rise[bank] | mask) : (pcint_rise[bank] & ~mask);
+        pcint_fall[bank] = (edge != GPIO_EDGE_RISING) ? (pcint_fall[bank] | mask) : (pcint_fall[bank] & ~mask);
+
+        // Fresh snapshot, so the first interrupt compares against the present level
+        pcint_last[bank] = (uint8_t)((pcint_last[bank] & ~mask) | (*(m->pin) & mask));
+        *(m->pcmsk) |= mask;
+        PCIFR = (uint8_t)(1 << bank);
+        PCICR |= (uint8_t)(1 << bank);
+    }
+
+    SREG = sreg;
+    return true;
+}
+
+bool gpio_detach_interrupt(gpio_pin_t pin) {
+    if (pin > PIN_A5) return false;
+
+    uint8_t sreg = SREG;
+    cli();
+
+    if (pin == PIN_D2 || pin == PIN_D3) {
+        EIMSK &= (uint8_t)~(1 << (pin - PIN_D2));
+    } else {
+        uint8_t bank = gpio_pcint_bank(pin);
+        const gpio_pcint_map_t *m = &gpio_pcint[bank];
+
+        *(m->pcmsk) &= (uint8_t)~GPIO_FAST_MASK(pin);
+        if (*(m->pcmsk) == 0) PCICR &= (uint8_t)~(1 << bank);
+    }
+    gpio_irq_cb[pin] = 0;
+
+    SREG = sreg;
+    return true;
+}
+
+/* Shared PCINT body: which enabled pins changed, in which direction */
+static inline void gpio_pcint_dispatch(uint8_t bank) {
+    const gpio_pcint_map_t *m = &gpio_pcint[bank];
+    uint8_t now = *(m->pin);
+    uint8_t changed = (uint8_t)((now ^ pcint_last[bank]) & *(m->pcmsk));
+    pcint_last[bank] = now;
+
+    uint8_t hits = (uint8_t)((changed & now & pcint_rise[bank]) |
+                             (changed & (uint8_t)~now & pcint_fall[bank]));
+    gpio_pin_t pin = m->first;
+    for (uint8_t bit = 1; hits; bit <<= 1, pin++) {
+        if (!(hits & bit)) continue;
+        hits &= (uint8_t)~bit;
+        gpio_irq_cb_t cb = gpio_irq_cb[pin];
+        if (cb) cb(pin, (now & bit) ? GPIO_HIGH : GPIO_LOW);
+    }
+}
+
+static inline void gpio_int_dispatch(gpio_pin_t pin) {
+    gpio_irq_cb_t cb = gpio_irq_cb[pin];
+    if (cb) cb(pin, (PIND & GPIO_FAST_MASK(pin)) ? GPIO_HIGH : GPIO_LOW);
+}
+
+#if !(GPIO_IRQ_USER_VECTORS & GPIO_IRQ_VEC_INT0)
+ISR(INT0_vect) { gpio_int_dispatch(PIN_D2); }
+#endif
+#if !(GPIO_IRQ_USER_VECTORS & GPIO_IRQ_VEC_INT1)
+ISR(INT1_vect) { gpio_int_dispatch(PIN_D3); }
+#endif
+#if !(GPIO_IRQ_USER_VECTORS & GPIO_IRQ_VEC_PCINT0)
+ISR(PCINT0_vect) { gpio_pcint_dispatch(GPIO_PORT_B); }
+#endif
+#if !(GPIO_IRQ_USER_VECTORS & GPIO_IRQ_VEC_PCINT1)
+ISR(PCINT1_vect) { gpio_pcint_dispatch(GPIO_PORT_C); }
+#endif
+#if !(GPIO_IRQ_USER_VECTORS & GPIO_IRQ_VEC_PCINT2)
+ISR(PCINT2_vect) { gpio_pcint_dispatch(GPIO_PORT_D); }
+#endif
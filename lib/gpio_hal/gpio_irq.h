@@ -0,0 +1,39 @@
+#ifndef GPIO_IRQ_H
+#define GPIO_IRQ_H
+#include "gpio.h"
+
+/* Pin interrupts keyed on the gpio_pin_t numbering of gpio_map[].
+ *   PIN_D2 / PIN_D3 -> INT0 / INT1 (edge or level detected in hardware)
+ *   other pins      -> PCINT bank of their port (any change; the edge is
+ *                      filtered in software against the previous PINx snapshot)
+ *     D8-D13 = PCINT0 (PORTB), A0-A5 = PCINT1 (PORTC), D0-D7 = PCINT2 (PORTD)
+ * Callbacks run in ISR context, one call per pin that changed.
+ *
+ * Naked fast path: list vectors in GPIO_IRQ_USER_VECTORS (build flag) and the
+ * library leaves them to the application, e.g.
+ *   -DGPIO_IRQ_USER_VECTORS=GPIO_IRQ_VEC_INT0
+ *   ISR(INT0_vect, ISR_NAKED) { PINB = _BV(PB5); reti(); }  // 2 instructions
+ * gpio_attach_interrupt(pin, edge, NULL) still configures the hardware. */
+#define GPIO_IRQ_VEC_INT0   0x01
+#define GPIO_IRQ_VEC_INT1   0x02
+#define GPIO_IRQ_VEC_PCINT0 0x04
+#define GPIO_IRQ_VEC_PCINT1 0x08
+#define GPIO_IRQ_VEC_PCINT2 0x10
+
+#ifndef GPIO_IRQ_USER_VECTORS
+#define GPIO_IRQ_USER_VECTORS 0
+#endif
+
+typedef enum {
+    GPIO_EDGE_CHANGE = 0,
+    GPIO_EDGE_FALLING,
+    GPIO_EDGE_RISING,
+    GPIO_LEVEL_LOW       // INT0/INT1 only: fires while the pin is low
+} gpio_edge_t;
+
+typedef void (*gpio_irq_cb_t)(gpio_pin_t pin, gpio_level_t level);
+
+bool gpio_attach_interrupt(gpio_pin_t pin, gpio_edge_t edge, gpio_irq_cb_t cb); // false on bad pin/edge
+bool gpio_detach_interrupt(gpio_pin_t pin);
+
+#endif
@@ -3,10 +3,12 @@
 // 1) Status-driven state checks:
 //      - After every TWI action (START, SLA+R/W, DATA, RX), wait for TWINT and then verify TWSR.
 //      - Each step maps the hardware status into a small set of return codes:
-//          I2C_OK, I2C_NACK, I2C_TIMEOUT_ERR, I2C_ERROR.
+//          I2C_OK, I2C_NACK, I2C_TIMEOUT_ERR, I2C_ARB_LOST, I2C_BUS_ERROR, I2C_ERROR,
+//          and I2C_STOP_TIMEOUT when only the final STOP failed.
 //
 //   2) Timeout protection:
-//      - twi_wait_twint() polls TWINT with a configurable I2C_TIMEOUT counter to avoid deadlocks.
+//      - twi_wait_twint() polls TWINT against a real-time deadline (I2C_TIMEOUT_US on the
+//        Timer0 timebase, i2c_set_timeout()) to avoid deadlocks.
 //
 //   3) START vs REPEATED START:
 //      - START and REPEATED START are generated identically (set TWSTA).
@@ -30,9 +32,60 @@
 //      - i2c_write_bytes() / i2c_read_bytes(): burst transfers with proper final NACK on read.
 //      - i2c_write_reg(): START(W) + reg + data... + STOP (common "register write" pattern).
 //      - i2c_read_reg():  START(W) + reg + RESTART(R) + data... + STOP (common "register read" pattern).
+//      - All four build an i2c_xfer_t and run it through the async engine (submit + wait).
+//
+//   8) Async engine:
+//      - TWI_vect runs one state-machine step per TWINT, using the same TWSR -> i2c_status_t
+//        mapping as the polled primitives; the CPU is free while the bus is busy.
+//      - Descriptors wait in a small ring (I2C_QUEUE_SIZE); finishing one starts the next.
+//      - Completion: xfer->status leaves I2C_BUSY, then the optional callback runs (ISR context).
+//      - With global interrupts disabled, i2c_wait() polls TWINT and steps the engine itself.
+//      - STOP: TWI_vect waits for TWSTO to clear for at most I2C_STOP_SPIN_US. If it is still
+//        set (a slave stretching SCL), the transaction stays current in PHASE_STOP and
+//        twi_stop_check() finishes it later: from the timebase hook, or from the poll paths
+//        (i2c_wait, i2c_idle, i2c_submit). Nothing else starts before TWSTO clears, and no
+//        ISR spins for the whole timeout.
+//      - I2C_SLEEP_WAIT: with interrupts enabled the waits sleep (IDLE) until TWI_vect; the
+//        polled primitives borrow TWIE just as a wake-up source.
+//
+//   9) Scatter-gather:
+//      - i2c_transfer() waits for the engine to go idle, locks it (twi_locked keeps
+//        twi_engine_kick() from starting queued work), then runs the segments on the polled
+//        primitives: START, REPEATED START (twi_send_start(1)) between segments, one STOP.
+//      - A read segment followed by an I2C_M_NOSTART read keeps ACKing across the boundary.
+//
+//  10) Bus clock:
+//      - fSCL = F_CPU / (16 + 2 * TWBR * 4^TWPS); twi_calc_clock() picks the smallest prescaler
+//        that fits TWBR in 8 bits and rounds TWBR up, so the bus never runs faster than asked.
+//      - twi_apply_clock() writes TWBR/TWSR only when the device differs from the last one.
+//
+//  11) Bus recovery (single-master bus assumed):
+//      - Before a blocking transaction the idle bus must read SDA = SCL = 1; otherwise it is
+//        recovered first instead of letting START run into the full timeout.
+//      - twi_recover_lines(): TWI off, SCL pulsed as open drain (DDR only) until SDA is free,
+//        START + STOP to reset every slave's state machine, TWI back on.
+//      - i2c_run() retries ARB_LOST / BUS_ERROR / TIMEOUT up to twi_retries times with a
+//        doubling backoff, but only while xfer->moved is clear (START / SLA phase). Once a
+//        byte went through, the bus is recovered and the failure reported: sending a FIFO
+//        or command write twice is worse. ARB_LOST is always retried (the slave saw the
+//        winner's bytes, not ours). STOP_TIMEOUT is never retried.
 
 #include "i2cMaster.h"
+#include "hal_stats.h"
 #include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/delay.h>
+
+// HAL_STATS_I2C() gets i2c_status_t values; hal_stats.c counts them by these names
+_Static_assert(HAL_STATS_I2C_NACK == I2C_NACK, "hal_stats.h out of sync with i2c_status_t");
+_Static_assert(HAL_STATS_I2C_TIMEOUT == I2C_TIMEOUT_ERR, "hal_stats.h out of sync with i2c_status_t");
+_Static_assert(HAL_STATS_I2C_ARB_LOST == I2C_ARB_LOST, "hal_stats.h out of sync with i2c_status_t");
+_Static_assert(HAL_STATS_I2C_BUS_ERROR == I2C_BUS_ERROR, "hal_stats.h out of sync with i2c_status_t");
+_Static_assert(HAL_STATS_I2C_STOP_TIMEOUT == I2C_STOP_TIMEOUT, "hal_stats.h out of sync with i2c_status_t");
+
+#if (I2C_QUEUE_SIZE < 1) || (I2C_QUEUE_SIZE > 128) || (I2C_QUEUE_SIZE & (I2C_QUEUE_SIZE - 1))
+#error "I2C_QUEUE_SIZE must be a power of two in 1..128"
+#endif
 
 // --------- TWI status codes (ATmega328P datasheet) ----------
 #define TW_STATUS_MASK 0xF8
@@ -57,6 +110,12 @@
 // Misc
 #define TW_BUS_ERROR 0x00
 
+// TWI pins (PORTC): SDA = A4, SCL = A5
+#define TWI_SDA_BIT PC4
+#define TWI_SCL_BIT PC5
+#define TWI_LINES   ((1 << TWI_SDA_BIT) | (1 << TWI_SCL_BIT))
+#define TWI_RECOVER_HALF_US 5   // 100 kHz bit-banged clock
+
 // Read twi status
 static inline uint8_t twi_status(void)
 {
@@ -64,15 +123,44 @@ static inline uint8_t twi_status(void)
     // read only first 5 bits - status bits(just saw it somewhere in the datasheet)
     return (uint8_t)(TWSR & TW_STATUS_MASK);
 }
+static uint32_t twi_timeout_us = I2C_TIMEOUT_US;
+static uint8_t twi_retries = I2C_RETRIES;
+static uint16_t twi_backoff_us = I2C_BACKOFF_US;
+
+// Unexpected TWSR after an action: tell arbitration loss and bus errors apart
+static inline i2c_status_t twi_fault(uint8_t s)
+{
+    if (s == TW_MT_ARB_LOST)
+        return I2C_ARB_LOST;
+    if (s == TW_BUS_ERROR)
+        return I2C_BUS_ERROR;
+    return I2C_ERROR;
+}
+
 // Polling TWINT flag with timeout (it set to 1 when operation complete)
 static i2c_status_t twi_wait_twint(void)
 {
-    uint32_t t = I2C_TIMEOUT;
+    uint32_t start = time_us();
+#if I2C_SLEEP_WAIT
+    // Let TWINT wake us: TWI_vect sees no engine transaction and only drops TWIE.
+    // TWINT is written back as 0, which never clears it.
+    bool sleep = (SREG & (1 << SREG_I)) != 0;
+    if (sleep)
+        TWCR = (uint8_t)((TWCR & ~(1 << TWINT)) | (1 << TWIE));
+#endif
     while (!(TWCR & (1 << TWINT)))
     {
-        if (--t == 0)
+        if (time_elapsed_us(start, twi_timeout_us))
+        {
+            HAL_STATS_WAIT(i2c_wait_max_us, start);
             return I2C_TIMEOUT_ERR;
+        }
+#if I2C_SLEEP_WAIT
+        if (sleep)
+            TIME_SLEEP_WHILE(!(TWCR & (1 << TWINT)));
+#endif
     }
+    HAL_STATS_WAIT(i2c_wait_max_us, start);
     return I2C_OK;
 }
 
@@ -89,11 +177,7 @@ static i2c_status_t twi_send_start(uint8_t allow_repeated)
     if (allow_repeated && s == TW_REP_START)
         return I2C_OK;
 
-    if (s == TW_MT_ARB_LOST)
-        return I2C_ERROR;
-    if (s == TW_BUS_ERROR)
-        return I2C_ERROR;
-    return I2C_ERROR;
+    return twi_fault(s);
 }
 
 static i2c_status_t twi_send_sla(uint8_t sla_rw, uint8_t expect_ack, uint8_t expect_nack)
@@ -110,28 +194,543 @@ static i2c_status_t twi_send_sla(uint8_t sla_rw, uint8_t expect_ack, uint8_t exp
     if (s == expect_nack)
         return I2C_NACK;
 
-    if (s == TW_MT_ARB_LOST)
-        return I2C_ERROR;
-    if (s == TW_BUS_ERROR)
+    return twi_fault(s);
+}
+
+// --------- Async engine state ----------
+// Queue indices and twi_cur are only modified with interrupts disabled
+// (inside TWI_vect or under cli() in i2c_submit/i2c_abort).
+enum {
+    PHASE_HDR = 0,  // sending xfer->hdr[]
+    PHASE_WRITE,    // sending xfer->wbuf[]
+    PHASE_READ,     // SLA+R sent / receiving xfer->rbuf[]
+    PHASE_STOP      // STOP issued, TWSTO not cleared yet (twi_stop_check)
+};
+
+static i2c_xfer_t *twi_queue[I2C_QUEUE_SIZE];
+static volatile uint8_t twi_q_head;      // next free slot
+static volatile uint8_t twi_q_tail;      // oldest queued (== twi_cur when running)
+static i2c_xfer_t *volatile twi_cur;     // running transaction or NULL
+static volatile uint8_t twi_events;      // bumped on every TWINT handled (progress for i2c_wait)
+static volatile bool twi_locked;         // i2c_transfer() owns the bus
+static i2c_device_t twi_bus;             // bus default clock (addr/reg_width unused)
+static const i2c_device_t *twi_clk_dev;  // device whose divider is loaded, NULL = unknown
+static uint8_t twi_phase;
+static uint16_t twi_idx;
+static uint8_t twi_stop_status;          // PHASE_STOP: result to report once the STOP is out
+static uint32_t twi_stop_since;          // PHASE_STOP: time_us() of the STOP (poll paths)
+static uint16_t twi_stop_ticks;          // PHASE_STOP: timebase ticks seen (hook)
+
+// STOP is not followed by TWINT: wait for the hardware to clear TWSTO
+static i2c_status_t twi_wait_stop(void)
+{
+    uint32_t start = time_us();
+    while (TWCR & (1 << TWSTO))
+    {
+        if (time_elapsed_us(start, twi_timeout_us))
+            return I2C_TIMEOUT_ERR;
+    }
+    return I2C_OK;
+}
+
+// TWBR/TWPS for scl_hz; I2C_ERROR when no divider reaches it
+static i2c_status_t twi_calc_clock(uint32_t scl_hz, uint8_t *twbr, uint8_t *twps)
+{
+    if (scl_hz == 0 || scl_hz > F_CPU / 16UL)
         return I2C_ERROR;
+
+    // 2 * TWBR * 4^ps >= F_CPU/fSCL - 16 (rounded up => fSCL never above scl_hz)
+    uint32_t div = (F_CPU + scl_hz - 1UL) / scl_hz - 16UL;
+    for (uint8_t ps = 0; ps < 4; ps++)
+    {
+        uint32_t step = 2UL << (2 * ps);
+        uint32_t br = (div + step - 1UL) / step;
+        if (br <= 255UL)
+        {
+            *twbr = (uint8_t)br;
+            *twps = ps;
+            return I2C_OK;
+        }
+    }
     return I2C_ERROR;
 }
 
+// Load dev's divider if another device ran last (bus idle: between STOP and START)
+static inline void twi_apply_clock(const i2c_device_t *dev)
+{
+    if (!dev)
+        dev = &twi_bus;
+    if (dev == twi_clk_dev)
+        return;
+    TWBR = dev->twbr;
+    TWSR = dev->twps; // status bits are read-only
+    twi_clk_dev = dev;
+}
+
+// Start the oldest queued transaction if the bus is ours to use (interrupts off)
+static void twi_engine_kick(void)
+{
+    if (twi_cur || twi_locked || twi_q_head == twi_q_tail)
+        return;
+
+    i2c_xfer_t *x = twi_queue[twi_q_tail & (I2C_QUEUE_SIZE - 1)];
+    bool has_write = x->hdr_len || x->wlen || !(x->flags & I2C_XFER_READ);
+
+    twi_apply_clock(x->dev);
+    twi_cur = x;
+    twi_phase = has_write ? PHASE_HDR : PHASE_READ;
+    twi_idx = 0;
+    TWCR = (1 << TWINT) | (1 << TWSTA) | (1 << TWEN) | (1 << TWIE);
+}
+
+// Complete twi_cur and move on (interrupts off). TWIE is dropped by the caller's TWCR write.
+static void twi_engine_finish(uint8_t status)
+{
+    i2c_xfer_t *x = twi_cur;
+
+    twi_cur = NULL;
+    twi_q_tail++;
+    x->status = status;
+    HAL_STATS_I2C(x->addr7, status);
+    if (x->callback)
+        x->callback(x);
+
+    twi_engine_kick();
+}
+
+static void twi_engine_stop(uint8_t status)
+{
+    TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWSTO);
+
+    // Normal case: the STOP is out within about one SCL period
+    uint32_t start = time_us();
+    while (TWCR & (1 << TWSTO))
+    {
+        if (time_elapsed_us(start, I2C_STOP_SPIN_US))
+        {
+            // SCL held: finish later (twi_stop_check) instead of spinning in the ISR
+            twi_phase = PHASE_STOP;
+            twi_stop_status = status;
+            twi_stop_since = start;
+            twi_stop_ticks = 0;
+            return;
+        }
+    }
+    twi_engine_finish(status);
+}
+
+// Complete a transaction left in PHASE_STOP (interrupts off). timed_out: the
+// caller's clock says the budget is spent.
+static void twi_stop_resolve(bool timed_out)
+{
+    uint8_t status = twi_stop_status;
+    if (TWCR & (1 << TWSTO))
+    {
+        if (!timed_out)
+            return;
+        // Still no STOP: TWI off and on releases our side of the lines
+        TWCR = 0;
+        TWCR = (1 << TWEN);
+        if (status == I2C_OK)
+            status = I2C_STOP_TIMEOUT; // data went through, but the bus is not released
+    }
+    twi_engine_finish(status);
+}
+
+// Poll paths (interrupts off): time_us() based
+static void twi_stop_check(void)
+{
+    if (!twi_cur || twi_phase != PHASE_STOP)
+        return;
+    bool late = time_elapsed_us(twi_stop_since, twi_timeout_us);
+    // time_us() may have run twi_stop_hook(), which can finish it first
+    if (twi_cur && twi_phase == PHASE_STOP)
+        twi_stop_resolve(late);
+}
+
+// Timebase hook (interrupts off, may run inside time_us()): counts ticks instead
+static void twi_stop_hook(void)
+{
+    if (twi_cur && twi_phase == PHASE_STOP)
+    {
+        if (twi_stop_ticks != 0xFFFF)
+            twi_stop_ticks++;
+        twi_stop_resolve(twi_timeout_us != TIME_FOREVER &&
+                         (uint32_t)twi_stop_ticks * TIMEBASE_US_PER_OVF >= twi_timeout_us);
+    }
+}
+
+// Request the next byte in Master Receiver mode: ACK all but the last one
+static inline void twi_engine_read_next(const i2c_xfer_t *x)
+{
+    if ((uint16_t)(twi_idx + 1) < x->rlen)
+        TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE) | (1 << TWEA);
+    else
+        TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+}
+
+// One state-machine step per TWINT (ISR context, or i2c_wait() with interrupts off)
+static void twi_engine_step(void)
+{
+    i2c_xfer_t *x = twi_cur;
+    if (!x)
+    {
+        // Not ours (polled primitives): just stop interrupting, keep TWINT set
+        TWCR &= (uint8_t)~((1 << TWIE) | (1 << TWINT));
+        return;
+    }
+
+    twi_events++;
+    switch (twi_status())
+    {
+    case TW_START:
+    case TW_REP_START:
+        TWDR = (uint8_t)((x->addr7 << 1) | (twi_phase == PHASE_READ ? 1 : 0));
+        TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+        break;
+
+    case TW_MT_DATA_ACK:
+        x->moved = 1; // the slave took a byte: resending would repeat it
+        // fall through
+    case TW_MT_SLA_ACK:
+        if (twi_phase == PHASE_HDR)
+        {
+            if (twi_idx < x->hdr_len)
+            {
+                TWDR = x->hdr[twi_idx++];
+                TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+                break;
+            }
+            twi_phase = PHASE_WRITE;
+            twi_idx = 0;
+        }
+        if (twi_idx < x->wlen)
+        {
+            TWDR = x->wbuf[twi_idx++];
+            TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+        }
+        else if (x->flags & I2C_XFER_READ)
+        {
+            twi_phase = PHASE_READ;
+            twi_idx = 0;
+            TWCR = (1 << TWINT) | (1 << TWSTA) | (1 << TWEN) | (1 << TWIE); // REPEATED START
+        }
+        else
+        {
+            twi_engine_stop(I2C_OK);
+        }
+        break;
+
+    case TW_MT_SLA_NACK:
+    case TW_MT_DATA_NACK:
+    case TW_MR_SLA_NACK:
+        twi_engine_stop(I2C_NACK);
+        break;
+
+    case TW_MR_SLA_ACK:
+        if (x->rlen == 0)
+            twi_engine_stop(I2C_OK);
+        else
+            twi_engine_read_next(x);
+        break;
+
+    case TW_MR_DATA_ACK:
+        x->moved = 1; // read side effects (FIFO pop) already happened
+        x->rbuf[twi_idx++] = TWDR;
+        twi_engine_read_next(x);
+        break;
+
+    case TW_MR_DATA_NACK:
+        x->moved = 1;
+        x->rbuf[twi_idx++] = TWDR; // last byte
+        twi_engine_stop(I2C_OK);
+        break;
+
+    case TW_MT_ARB_LOST: // same code in MR mode
+        // Hardware already released the bus; leave it to the winner
+        TWCR = (1 << TWINT) | (1 << TWEN);
+        twi_engine_finish(I2C_ARB_LOST);
+        break;
+
+    case TW_BUS_ERROR:
+        // Datasheet: TWSTO + TWINT recovers from a bus error without sending STOP
+        TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWSTO);
+        twi_engine_finish(I2C_BUS_ERROR);
+        break;
+
+    default:
+        TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWSTO);
+        twi_engine_finish(I2C_ERROR);
+        break;
+    }
+}
+
+ISR(TWI_vect)
+{
+    twi_engine_step();
+}
+
+i2c_status_t i2c_submit(i2c_xfer_t *xfer)
+{
+    if (!xfer || (xfer->hdr_len > I2C_XFER_HDR_MAX) ||
+        (!xfer->wbuf && xfer->wlen) || (!xfer->rbuf && xfer->rlen))
+        return I2C_ERROR;
+
+    uint8_t sreg = SREG;
+    cli(); // the queue may also be fed from callbacks (ISR context)
+
+    twi_stop_check();
+    if ((uint8_t)(twi_q_head - twi_q_tail) >= I2C_QUEUE_SIZE)
+    {
+        SREG = sreg;
+        return I2C_BUSY;
+    }
+    xfer->status = I2C_BUSY;
+    xfer->moved = 0;
+    twi_queue[twi_q_head & (I2C_QUEUE_SIZE - 1)] = xfer;
+    twi_q_head++;
+    twi_engine_kick();
+
+    SREG = sreg;
+    return I2C_OK;
+}
+
+// One poll of a blocking wait: step the engine when TWI_vect cannot run, and
+// abort everything once the bus made no progress for the per-event timeout
+// (the same budget as twi_wait_twint(), restarted on every TWINT).
+static void twi_engine_poll(uint32_t *since, uint8_t *seen)
+{
+    uint8_t sreg = SREG;
+    cli();
+    twi_stop_check();
+    SREG = sreg;
+
+    if (!(SREG & (1 << SREG_I)))
+    {
+        if (TWCR & (1 << TWINT))
+            twi_engine_step();
+    }
+#if I2C_SLEEP_WAIT
+    else
+    {
+        // Every engine step bumps twi_events: sleep until TWI_vect (or the timebase tick)
+        TIME_SLEEP_WHILE(twi_events == *seen);
+    }
+#endif
+
+    if (twi_events != *seen)
+    {
+        *seen = twi_events;
+        *since = time_us();
+    }
+    else if (time_elapsed_us(*since, twi_timeout_us))
+    {
+        i2c_abort();
+        *since = time_us();
+    }
+}
+
+i2c_status_t i2c_wait(i2c_xfer_t *xfer)
+{
+    if (!xfer)
+        return I2C_ERROR;
+
+    uint32_t since = time_us();
+#if HAL_STATS
+    uint32_t start = since;
+#endif
+    uint8_t seen = twi_events;
+    while (xfer->status == I2C_BUSY)
+        twi_engine_poll(&since, &seen);
+    HAL_STATS_WAIT(i2c_wait_max_us, start);
+
+    return (i2c_status_t)xfer->status;
+}
+
+bool i2c_idle(void)
+{
+    uint8_t sreg = SREG;
+    cli();
+    twi_stop_check();
+    SREG = sreg;
+    return twi_cur == NULL && twi_q_head == twi_q_tail && !twi_locked;
+}
+
+void i2c_abort(void)
+{
+    uint8_t sreg = SREG;
+    cli();
+
+    // Disabling TWI releases SDA/SCL immediately
+    TWCR = 0;
+    TWCR = (1 << TWEN);
+
+    twi_cur = NULL;
+    twi_locked = false;
+    while (twi_q_head != twi_q_tail)
+    {
+        i2c_xfer_t *x = twi_queue[twi_q_tail & (I2C_QUEUE_SIZE - 1)];
+        twi_q_tail++;
+        x->status = I2C_TIMEOUT_ERR;
+        HAL_STATS_I2C(x->addr7, I2C_TIMEOUT_ERR);
+        if (x->callback)
+            x->callback(x);
+    }
+
+    SREG = sreg;
+}
+
+void i2c_set_timeout(uint32_t timeout_us)
+{
+    twi_timeout_us = timeout_us;
+}
+
+void i2c_set_retry(uint8_t retries, uint16_t backoff_us)
+{
+    twi_retries = retries;
+    twi_backoff_us = backoff_us;
+}
+
+// --------- BUS RECOVERY ----------
+static inline bool twi_bus_free(void)
+{
+    return (PINC & TWI_LINES) == TWI_LINES;
+}
+
+// Open drain by hand: PORT bit 0, DDR selects low (1) or released (0).
+// Constant single-bit DDRC/PORTC updates compile to SBI/CBI, so no cli() needed.
+static inline void twi_line_low(uint8_t bit)  { DDRC |= (uint8_t)(1 << bit); }
+static inline void twi_line_free(uint8_t bit) { DDRC &= (uint8_t)~(1 << bit); }
+
+// Release SCL and wait for it to go high (slaves may stretch the clock)
+static bool twi_scl_release(void)
+{
+    twi_line_free(TWI_SCL_BIT);
+    uint32_t start = time_us();
+    while (!(PINC & (1 << TWI_SCL_BIT)))
+    {
+        if (time_elapsed_us(start, twi_timeout_us))
+            return false;
+    }
+    _delay_us(TWI_RECOVER_HALF_US);
+    return true;
+}
+
+// TWI must not be running a transaction (engine idle or locked)
+static i2c_status_t twi_recover_lines(void)
+{
+    uint8_t port = PORTC & TWI_LINES;
+    uint8_t ddr = DDRC & TWI_LINES;
+    HAL_STATS_INC(i2c_recoveries);
+
+    TWCR = 0; // TWI off: SDA/SCL back to PORTC
+    twi_line_free(TWI_SDA_BIT);
+    twi_line_free(TWI_SCL_BIT);
+    PORTC &= (uint8_t)~(1 << TWI_SDA_BIT); // no internal pull-ups while bit-banging
+    PORTC &= (uint8_t)~(1 << TWI_SCL_BIT);
+
+    bool scl_ok = twi_scl_release();
+
+    // A slave mid-read shifts out at most 8 more bits + ACK
+    for (uint8_t i = 0; i < 9 && scl_ok && !(PINC & (1 << TWI_SDA_BIT)); i++)
+    {
+        twi_line_low(TWI_SCL_BIT);
+        _delay_us(TWI_RECOVER_HALF_US);
+        scl_ok = twi_scl_release();
+    }
+
+    if (scl_ok && (PINC & (1 << TWI_SDA_BIT)))
+    {
+        // START then STOP (SDA low -> high while SCL high) resets every slave
+        twi_line_low(TWI_SDA_BIT);
+        _delay_us(TWI_RECOVER_HALF_US);
+        twi_line_free(TWI_SDA_BIT);
+        _delay_us(TWI_RECOVER_HALF_US);
+    }
+
+    i2c_status_t st = twi_bus_free() ? I2C_OK : I2C_BUS_ERROR;
+
+    // Pin setup back as the application left it, then TWI takes the pins again
+    uint8_t sreg = SREG;
+    cli();
+    PORTC = (uint8_t)((PORTC & ~TWI_LINES) | port);
+    DDRC = (uint8_t)((DDRC & ~TWI_LINES) | ddr);
+    SREG = sreg;
+    TWCR = (1 << TWEN);
+    return st;
+}
+
+i2c_status_t i2c_bus_recover(void)
+{
+    uint8_t sreg = SREG;
+    cli();
+    twi_locked = true; // nothing new starts while the pins are bit-banged
+    if (twi_cur)
+    {
+        TWCR = 0; // drop TWIE/TWINT before finishing
+        twi_engine_finish(I2C_BUS_ERROR);
+    }
+    SREG = sreg;
+
+    i2c_status_t st = twi_recover_lines();
+
+    sreg = SREG;
+    cli();
+    twi_locked = false;
+    twi_engine_kick();
+    SREG = sreg;
+    return st;
+}
+
+i2c_status_t i2c_set_clock(uint32_t scl_hz)
+{
+    uint8_t twbr, twps;
+    if (twi_calc_clock(scl_hz, &twbr, &twps) != I2C_OK)
+        return I2C_ERROR;
+
+    uint8_t sreg = SREG;
+    cli();
+    twi_bus.twbr = twbr;
+    twi_bus.twps = twps;
+    if (twi_clk_dev == &twi_bus)
+        twi_clk_dev = NULL; // reload before the next bus-default transaction
+    SREG = sreg;
+    return I2C_OK;
+}
+
 void i2c_init(void)
 {
-    // prescaler = 1 => TWPS = 0
-    TWSR = 0x00;
+    timebase_init(); // timeouts run on the shared timebase
+    timebase_add_hook(twi_stop_hook); // without a free slot the poll paths still finish STOPs
+
+    // TWI clock on (i2c_deinit() gates it); registers ignore writes while gated
+    PRR &= (uint8_t)~(1 << PRTWI);
 
-    // fSCL = F_CPU / (16 + 2*TWBR*prescaler)
-    // => TWBR = ((F_CPU/fSCL) - 16) / 2
-    uint32_t twbr = ((F_CPU / I2C_SCL_FREQ) - 16UL) / 2UL;
-    if (twbr > 255UL)
-        twbr = 255UL; // 8-bit register limit
-    TWBR = (uint8_t)twbr;
+    // Drop anything left from a previous init
+    i2c_abort();
+
+    // Out-of-range I2C_SCL_FREQ: fall back to the slowest divider
+    if (i2c_set_clock(I2C_SCL_FREQ) != I2C_OK)
+    {
+        twi_bus.twbr = 255;
+        twi_bus.twps = 3;
+    }
+    twi_clk_dev = NULL;
+    twi_apply_clock(&twi_bus);
 
     // Enable TWI
     TWCR = (1 << TWEN);
-};
+}
+
+void i2c_deinit(void)
+{
+    // Fail whatever is queued, then TWI off: SDA/SCL are released
+    i2c_abort();
+    TWCR = 0;
+    twi_clk_dev = NULL; // reload the divider after the next init
+
+    PRR |= (1 << PRTWI);
+}
 
 //-------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------
@@ -170,15 +769,11 @@ i2c_status_t i2c_restart_read(uint8_t addr7)
     return twi_send_sla((uint8_t)((addr7 << 1) | 1), TW_MR_SLA_ACK, TW_MR_SLA_NACK);
 }
 
-void i2c_stop(void)
+i2c_status_t i2c_stop(void)
 {
     TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWSTO);
     // Datasheet: TWINT is NOT set after a STOP condition has been sent (so wait for TWSTO here)
-    uint32_t t = I2C_TIMEOUT;
-    while ((TWCR & (1 << TWSTO)) && --t)
-    {
-        ;
-    }
+    return twi_wait_stop();
 }
 
 // --------- WRITE / READ ----------
@@ -193,9 +788,7 @@ i2c_status_t i2c_write(uint8_t data) {
     if (s == TW_MT_DATA_ACK)  return I2C_OK;
     if (s == TW_MT_DATA_NACK) return I2C_NACK;
 
-    if (s == TW_MT_ARB_LOST) return I2C_ERROR;
-    if (s == TW_BUS_ERROR)   return I2C_ERROR;
-    return I2C_ERROR;
+    return twi_fault(s);
 }
 
 i2c_status_t i2c_read_ack(uint8_t *out) {
@@ -208,7 +801,7 @@ i2c_status_t i2c_read_ack(uint8_t *out) {
     if (st != I2C_OK) return st;
 
     uint8_t s = twi_status();
-    if (s != TW_MR_DATA_ACK) return I2C_ERROR;
+    if (s != TW_MR_DATA_ACK) return twi_fault(s);
 
     *out = TWDR;
     return I2C_OK;
@@ -224,7 +817,7 @@ i2c_status_t i2c_read_nack(uint8_t *out) {
     if (st != I2C_OK) return st;
 
     uint8_t s = twi_status();
-    if (s != TW_MR_DATA_NACK) return I2C_ERROR;
+    if (s != TW_MR_DATA_NACK) return twi_fault(s);
 
     *out = TWDR;
     return I2C_OK;
@@ -232,79 +825,285 @@ i2c_status_t i2c_read_nack(uint8_t *out) {
 
 
 // --------- HELPERS ----------
-i2c_status_t i2c_write_bytes(uint8_t addr7, const uint8_t *data, uint16_t len) {
-    if (!data && len) return I2C_ERROR;
+// Blocking wrappers: describe the transfer, queue it, wait for the engine.
+static i2c_status_t i2c_run_once(i2c_xfer_t *x)
+{
+    uint32_t since = time_us();
+    uint8_t seen = twi_events;
 
-    i2c_status_t st = i2c_start_write(addr7);
-    if (st != I2C_OK) { i2c_stop(); return st; }
+    // Stuck idle bus: recover now rather than time out in START
+    if (i2c_idle() && !twi_bus_free() && i2c_bus_recover() != I2C_OK)
+        return I2C_BUS_ERROR;
 
-    for (uint16_t i = 0; i < len; i++) {
-        st = i2c_write(data[i]);
-        if (st != I2C_OK) { i2c_stop(); return st; }
+    i2c_status_t st = i2c_submit(x);
+    while (st == I2C_BUSY)
+    {
+        // Queue full: let earlier transactions drain
+        twi_engine_poll(&since, &seen);
+        st = i2c_submit(x);
     }
+    if (st != I2C_OK)
+        return st;
+    return i2c_wait(x);
+}
 
-    i2c_stop();
-    return I2C_OK;
+// i2c_run_once() under the retry/backoff policy
+static i2c_status_t i2c_run(i2c_xfer_t *x)
+{
+    uint8_t tries = twi_retries;
+    uint32_t backoff = twi_backoff_us;
+
+    while (1)
+    {
+        i2c_status_t st = i2c_run_once(x);
+        if (st == I2C_OK || st == I2C_NACK || st == I2C_ERROR)
+            return st;
+        if (st == I2C_STOP_TIMEOUT || (x->moved && st != I2C_ARB_LOST))
+        {
+            i2c_bus_recover(); // free the bus, but never resend accepted data
+            return st;
+        }
+        if (tries == 0)
+            return st;
+        tries--;
+
+        if (st != I2C_ARB_LOST)
+            i2c_bus_recover();
+
+        uint32_t start = time_us();
+        while (!time_elapsed_us(start, backoff))
+        {
+            ;
+        }
+        backoff <<= 1;
+    }
+}
+
+i2c_status_t i2c_write_bytes(uint8_t addr7, const uint8_t *data, uint16_t len) {
+    if (!data && len) return I2C_ERROR;
+
+    i2c_xfer_t x = { .addr7 = addr7, .wbuf = data, .wlen = len };
+    return i2c_run(&x);
 }
 
 i2c_status_t i2c_read_bytes(uint8_t addr7, uint8_t *data, uint16_t len) {
     if (!data && len) return I2C_ERROR;
 
-    i2c_status_t st = i2c_start_read(addr7);
-    if (st != I2C_OK) { i2c_stop(); return st; }
+    i2c_xfer_t x = { .addr7 = addr7, .flags = I2C_XFER_READ, .rbuf = data, .rlen = len };
+    return i2c_run(&x);
+}
+
+
+// Write register: START(W) + reg + data... + STOP
+i2c_status_t i2c_write_reg(uint8_t addr7, uint8_t reg, const uint8_t *data, uint16_t len) {
+    if (!data && len) return I2C_ERROR;
+
+    i2c_xfer_t x = { .addr7 = addr7, .hdr = { reg }, .hdr_len = 1, .wbuf = data, .wlen = len };
+    return i2c_run(&x);
+}
+
+// Read register: START(W) + reg + RESTART(R) + read... + STOP
+i2c_status_t i2c_read_reg(uint8_t addr7, uint8_t reg, uint8_t *data, uint16_t len) {
+    if (!data && len) return I2C_ERROR;
+
+    i2c_xfer_t x = { .addr7 = addr7, .flags = I2C_XFER_READ, .hdr = { reg }, .hdr_len = 1,
+                     .rbuf = data, .rlen = len };
+    return i2c_run(&x);
+}
 
-    if (len == 0) { i2c_stop(); return I2C_OK; }
 
-    for (uint16_t i = 0; i < len; i++) {
-        if (i == (len - 1)) st = i2c_read_nack(&data[i]); // last byte => NACK
-        else                st = i2c_read_ack(&data[i]);  // remaining bytes => ACK
+// --------- SCATTER-GATHER ----------
+// Wait for the engine to drain, then keep it from starting new work
+static void twi_lock(void)
+{
+    uint32_t since = time_us();
+    uint8_t seen = twi_events;
 
-        if (st != I2C_OK) { i2c_stop(); return st; }
+    while (1)
+    {
+        uint8_t sreg = SREG;
+        cli();
+        if (i2c_idle())
+        {
+            twi_locked = true;
+            SREG = sreg;
+            return;
+        }
+        SREG = sreg;
+        twi_engine_poll(&since, &seen);
     }
+}
 
-    i2c_stop();
-    return I2C_OK;
+// Hand the bus back and start whatever was queued meanwhile
+static void twi_unlock(void)
+{
+    uint8_t sreg = SREG;
+    cli();
+    twi_locked = false;
+    twi_engine_kick();
+    SREG = sreg;
 }
 
+i2c_status_t i2c_transfer(const i2c_msg_t *msgs, uint8_t n)
+{
+    return i2c_dev_transfer(NULL, msgs, n);
+}
 
-// Write register: START(W) + reg + data... + STOP
-i2c_status_t i2c_write_reg(uint8_t addr7, uint8_t reg, const uint8_t *data, uint16_t len) {
-    i2c_status_t st = i2c_start_write(addr7);
-    if (st != I2C_OK) { i2c_stop(); return st; }
+i2c_status_t i2c_dev_transfer(const i2c_device_t *dev, const i2c_msg_t *msgs, uint8_t n)
+{
+    if (!msgs || n == 0 || (msgs[0].flags & I2C_M_NOSTART))
+        return I2C_ERROR;
+    for (uint8_t i = 0; i < n; i++)
+    {
+        if (!msgs[i].buf && msgs[i].len)
+            return I2C_ERROR;
+        // Continuing a segment cannot change the address or the direction
+        if (i && (msgs[i].flags & I2C_M_NOSTART) &&
+            (((msgs[i].flags ^ msgs[i - 1].flags) & I2C_M_RD) || msgs[i].addr7 != msgs[i - 1].addr7))
+            return I2C_ERROR;
+    }
+
+    twi_lock();
+    twi_apply_clock(dev);
+
+    i2c_status_t st = I2C_OK;
+    uint8_t addr7 = msgs[0].addr7; // segment that failed, for the stats
+    if (!twi_bus_free() && twi_recover_lines() != I2C_OK)
+        st = I2C_BUS_ERROR;
+    for (uint8_t i = 0; i < n && st == I2C_OK; i++)
+    {
+        const i2c_msg_t *m = &msgs[i];
+        addr7 = m->addr7;
+        bool rd = (m->flags & I2C_M_RD) != 0;
 
-    st = i2c_write(reg);
-    if (st != I2C_OK) { i2c_stop(); return st; }
+        if (!(m->flags & I2C_M_NOSTART))
+        {
+            if (i == 0)
+                st = rd ? i2c_start_read(m->addr7) : i2c_start_write(m->addr7);
+            else
+                st = rd ? i2c_restart_read(m->addr7) : i2c_restart_write(m->addr7);
+        }
 
-    for (uint16_t i = 0; i < len; i++) {
-        st = i2c_write(data[i]);
-        if (st != I2C_OK) { i2c_stop(); return st; }
+        if (rd)
+        {
+            // NACK only the very last byte of the read stream
+            bool more = (uint8_t)(i + 1) < n && (msgs[i + 1].flags & I2C_M_NOSTART);
+            for (uint16_t j = 0; j < m->len && st == I2C_OK; j++)
+            {
+                if ((uint16_t)(j + 1) < m->len || more)
+                    st = i2c_read_ack(&m->buf[j]);
+                else
+                    st = i2c_read_nack(&m->buf[j]);
+            }
+        }
+        else
+        {
+            for (uint16_t j = 0; j < m->len && st == I2C_OK; j++)
+                st = i2c_write(m->buf[j]);
+        }
     }
 
-    i2c_stop();
-    return I2C_OK;
+    if (st == I2C_TIMEOUT_ERR || st == I2C_BUS_ERROR)
+    {
+        // Slave or hardware stuck mid-byte: clock the bus free
+        twi_recover_lines();
+    }
+    else if (st == I2C_ARB_LOST)
+    {
+        // The winner owns the bus: release TWINT without a STOP
+        TWCR = (1 << TWINT) | (1 << TWEN);
+    }
+    else if (i2c_stop() != I2C_OK)
+    {
+        st = I2C_STOP_TIMEOUT;
+        twi_recover_lines();
+    }
+
+    HAL_STATS_I2C(addr7, st);
+    (void)addr7;
+    twi_unlock();
+    return st;
 }
 
-// Read register: START(W) + reg + RESTART(R) + read... + STOP
-i2c_status_t i2c_read_reg(uint8_t addr7, uint8_t reg, uint8_t *data, uint16_t len) {
-    if (!data && len) return I2C_ERROR;
 
-    i2c_status_t st = i2c_start_write(addr7);
-    if (st != I2C_OK) { i2c_stop(); return st; }
+// --------- DEVICE HANDLES ----------
+i2c_status_t i2c_device_init(i2c_device_t *dev, uint8_t addr7, uint32_t scl_hz,
+                             uint8_t reg_width, uint8_t retries)
+{
+    if (!dev || addr7 > 0x7F || reg_width < 1 || reg_width > I2C_XFER_HDR_MAX)
+        return I2C_ERROR;
 
-    st = i2c_write(reg);
-    if (st != I2C_OK) { i2c_stop(); return st; }
+    uint8_t twbr, twps;
+    if (twi_calc_clock(scl_hz, &twbr, &twps) != I2C_OK)
+        return I2C_ERROR;
 
-    st = i2c_restart_read(addr7);
-    if (st != I2C_OK) { i2c_stop(); return st; }
+    uint8_t sreg = SREG;
+    cli();
+    dev->addr7 = addr7;
+    dev->reg_width = reg_width;
+    dev->retries = retries;
+    dev->twbr = twbr;
+    dev->twps = twps;
+    if (twi_clk_dev == dev)
+        twi_clk_dev = NULL; // re-initialised handle: reload its divider
+    SREG = sreg;
+    return I2C_OK;
+}
 
-    if (len == 0) { i2c_stop(); return I2C_OK; }
+// i2c_run() with the device's retry policy (only NACK is worth retrying, and
+// only before any byte went through: a NACK mid-write follows accepted data)
+static i2c_status_t i2c_dev_run(const i2c_device_t *dev, i2c_xfer_t *x)
+{
+    i2c_status_t st;
+    uint8_t tries = dev->retries;
+    while ((st = i2c_run(x)) == I2C_NACK && !x->moved && tries)
+        tries--;
+    return st;
+}
 
-    for (uint16_t i = 0; i < len; i++) {
-        if (i == (len - 1)) st = i2c_read_nack(&data[i]); // last byte => NACK
-        else                st = i2c_read_ack(&data[i]);  // remaining bytes => ACK
-        if (st != I2C_OK) { i2c_stop(); return st; }
+// Register address as dev->reg_width big-endian header bytes
+static inline void i2c_dev_hdr(const i2c_device_t *dev, i2c_xfer_t *x, uint16_t reg)
+{
+    if (dev->reg_width == 2)
+    {
+        x->hdr[0] = (uint8_t)(reg >> 8);
+        x->hdr[1] = (uint8_t)reg;
+    }
+    else
+    {
+        x->hdr[0] = (uint8_t)reg;
     }
+    x->hdr_len = dev->reg_width;
+}
 
-    i2c_stop();
-    return I2C_OK;
+i2c_status_t i2c_dev_write(const i2c_device_t *dev, const uint8_t *data, uint16_t len) {
+    if (!dev || (!data && len)) return I2C_ERROR;
+
+    i2c_xfer_t x = { .dev = dev, .addr7 = dev->addr7, .wbuf = data, .wlen = len };
+    return i2c_dev_run(dev, &x);
+}
+
+i2c_status_t i2c_dev_read(const i2c_device_t *dev, uint8_t *data, uint16_t len) {
+    if (!dev || (!data && len)) return I2C_ERROR;
+
+    i2c_xfer_t x = { .dev = dev, .addr7 = dev->addr7, .flags = I2C_XFER_READ,
+                     .rbuf = data, .rlen = len };
+    return i2c_dev_run(dev, &x);
+}
+
+i2c_status_t i2c_dev_write_reg(const i2c_device_t *dev, uint16_t reg, const uint8_t *data, uint16_t len) {
+    if (!dev || (!data && len)) return I2C_ERROR;
+
+    i2c_xfer_t x = { .dev = dev, .addr7 = dev->addr7, .wbuf = data, .wlen = len };
+    i2c_dev_hdr(dev, &x, reg);
+    return i2c_dev_run(dev, &x);
+}
+
+i2c_status_t i2c_dev_read_reg(const i2c_device_t *dev, uint16_t reg, uint8_t *data, uint16_t len) {
+    if (!dev || (!data && len)) return I2C_ERROR;
+
+    i2c_xfer_t x = { .dev = dev, .addr7 = dev->addr7, .flags = I2C_XFER_READ,
+                     .rbuf = data, .rlen = len };
+    i2c_dev_hdr(dev, &x, reg);
+    return i2c_dev_run(dev, &x);
 }
@@ -2,46 +2,187 @@
 #define I2C_MASTER_H
 
 #include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
 #include <avr/io.h>
+#include "timebase.h"
 // Default I2C settings
 #ifndef F_CPU
 #define F_CPU 16000000UL
 #endif
 
+// Bus default clock (i2c_set_clock() at run time, i2c_device_t per device)
 #ifndef I2C_SCL_FREQ
 #define I2C_SCL_FREQ 100000UL
 #endif
 
-#ifndef I2C_TIMEOUT
-#define I2C_TIMEOUT 60000UL 
+// Longest wait for one bus event (TWINT, STOP), in microseconds on the shared
+// timebase. Covers a byte at 10 kHz plus clock stretching; change at run time
+// with i2c_set_timeout().
+#ifdef I2C_TIMEOUT
+#error "I2C_TIMEOUT (poll-loop count) was replaced by I2C_TIMEOUT_US (microseconds)"
+#endif
+#ifndef I2C_TIMEOUT_US
+#define I2C_TIMEOUT_US 10000UL
+#endif
+
+// Blocking helpers retry a failed transaction (arbitration lost, bus error,
+// timeout) after a backoff that doubles each attempt; bus errors and timeouts
+// run i2c_bus_recover() first. NACK is only retried per i2c_device_t.
+// A transaction is never resent once a byte after the address went through
+// (xfer->moved): FIFO and command writes must not reach the slave twice.
+// Arbitration loss is the exception: the slave only ever saw the winner.
+// Change at run time with i2c_set_retry().
+#ifndef I2C_RETRIES
+#define I2C_RETRIES 2
+#endif
+#ifndef I2C_BACKOFF_US
+#define I2C_BACKOFF_US 100U
+#endif
+
+// Blocking waits (i2c_wait, helpers, polled primitives) sleep in SLEEP_MODE_IDLE
+// until TWI_vect instead of spinning on TWINT. Same API and timeouts; only
+// applies while global interrupts are enabled.
+#ifndef I2C_SLEEP_WAIT
+#define I2C_SLEEP_WAIT 0
+#endif
+
+// Transactions that can wait in the async queue (power of two)
+#ifndef I2C_QUEUE_SIZE
+#define I2C_QUEUE_SIZE 4
+#endif
+
+// STOP raises no TWINT. TWI_vect polls TWSTO for at most this long (a STOP
+// takes about one SCL period: 10 us at 100 kHz). A STOP held up by a slave
+// stretching SCL is finished outside the ISR, from the timebase tick (every
+// 1.024 ms) or from i2c_wait()/i2c_idle()/i2c_submit(). It fails with
+// I2C_STOP_TIMEOUT after the i2c_set_timeout() budget.
+#ifndef I2C_STOP_SPIN_US
+#define I2C_STOP_SPIN_US 20U
 #endif
 
 typedef enum {
     I2C_OK    = 0,
     I2C_NACK  = 1,
     I2C_ERROR = 2,
-    I2C_TIMEOUT_ERR = 3
+    I2C_TIMEOUT_ERR = 3,
+    I2C_BUSY  = 4,  // transaction queued or in progress / queue full
+    I2C_ARB_LOST  = 5,  // another master won the bus (nothing to recover)
+    I2C_BUS_ERROR = 6,  // illegal START/STOP or SDA/SCL held low
+    I2C_STOP_TIMEOUT = 7 // all bytes went through, the STOP did not complete (bus recovered, not retried)
 } i2c_status_t;
 
+// ---------- Per-device handles ----------
+// SCL divider (TWBR + prescaler) is computed once in i2c_device_init() and only
+// written to the hardware when a transaction for a different device starts, so
+// a 400 kHz sensor and a 100 kHz EEPROM can share the bus at full speed each.
+// The ATmega328P TWI is specified up to 400 kHz; 1 MHz works at 16 MHz (TWBR = 0)
+// if the pull-ups are strong enough for the rise time.
+typedef struct {
+    uint8_t addr7;
+    uint8_t reg_width;      // register address bytes: 1, or 2 (big-endian)
+    uint8_t retries;        // extra attempts on NACK (EEPROM write cycle, busy sensor)
+    uint8_t twbr;           // cached divider
+    uint8_t twps;           // cached prescaler bits (TWSR[1:0])
+} i2c_device_t;
+
+// ---------- Async transaction engine (TWI_vect) ----------
+// One descriptor = START, SLA+W, hdr[] + wbuf[], then (I2C_XFER_READ)
+// REPEATED START, SLA+R, rbuf[], STOP. Write-only and read-only forms skip
+// the other phase. The descriptor is owned by the driver from i2c_submit()
+// until status leaves I2C_BUSY, so it must stay alive (not on a returning stack).
+#define I2C_XFER_READ    0x01   // has a read phase (even with rlen == 0)
+#define I2C_XFER_HDR_MAX 2      // register address bytes sent before wbuf
+
+typedef struct i2c_xfer i2c_xfer_t;
+typedef void (*i2c_callback_t)(i2c_xfer_t *xfer); // runs in ISR context
+
+struct i2c_xfer {
+    const i2c_device_t *dev;        // clock to run at, NULL = bus default
+    uint8_t addr7;
+    uint8_t flags;                  // I2C_XFER_*
+    uint8_t hdr[I2C_XFER_HDR_MAX];
+    uint8_t hdr_len;
+    const uint8_t *wbuf;
+    uint16_t wlen;
+    uint8_t *rbuf;
+    uint16_t rlen;
+    i2c_callback_t callback;        // optional
+    void *user;                     // free for the callback
+    volatile uint8_t status;        // i2c_status_t, I2C_BUSY until done
+    volatile uint8_t moved;         // set by the engine: a hdr/wbuf byte was ACKed or an rbuf byte received
+};
+
 void i2c_init(void);
+void i2c_deinit(void);                     // abort queued work, release the bus, gate TWI via PRR
+void i2c_set_timeout(uint32_t timeout_us); // per bus event, TIME_FOREVER disables
+i2c_status_t i2c_set_clock(uint32_t scl_hz); // bus default, I2C_ERROR if out of range
+void i2c_set_retry(uint8_t retries, uint16_t backoff_us);
+
+// Free a bus held by a slave stuck mid-byte: TWI off, up to 9 SCL pulses on A5
+// until SDA (A4) is released, a STOP, then TWI back on. Fails the running
+// transaction with I2C_BUS_ERROR; queued ones continue afterwards.
+// I2C_OK when both lines are high again, I2C_BUS_ERROR otherwise.
+i2c_status_t i2c_bus_recover(void);
+
+i2c_status_t i2c_submit(i2c_xfer_t *xfer);  // I2C_OK queued, I2C_BUSY queue full
+i2c_status_t i2c_wait(i2c_xfer_t *xfer);    // block until done, I2C_TIMEOUT_ERR if the bus stalls
+bool         i2c_idle(void);                // nothing queued or running
+void         i2c_abort(void);               // reset TWI, fail everything queued with I2C_TIMEOUT_ERR
+
+static inline bool i2c_done(const i2c_xfer_t *xfer)
+{
+    return xfer->status != I2C_BUSY;
+}
+
+// ---------- Scatter-gather transfer (Linux i2c_msg style) ----------
+// Segments are chained with REPEATED START and closed by a single STOP, so the
+// bus is never released between them. I2C_M_NOSTART continues the previous
+// segment's byte stream (same address and direction, no START / SLA).
+#define I2C_M_RD      0x01      // read segment (default: write)
+#define I2C_M_NOSTART 0x02      // no (repeated) START + address before this segment
+
+typedef struct {
+    uint8_t addr7;
+    uint8_t flags;              // I2C_M_*
+    uint16_t len;
+    uint8_t *buf;               // read into / written from (not modified on writes)
+} i2c_msg_t;
+
+// Blocking: waits for the async queue to drain, owns the bus until the STOP.
+// Returns the first failing segment's status; the bus is always released
+// (recovered on bus error / timeout). Not retried: segments need not be idempotent.
+i2c_status_t i2c_transfer(const i2c_msg_t *msgs, uint8_t n);      // bus default clock
+i2c_status_t i2c_dev_transfer(const i2c_device_t *dev, const i2c_msg_t *msgs, uint8_t n);
+
+// ---------- Step-by-step (polled) primitives ----------
+// Drive the bus directly; only use them while i2c_idle().
 
 i2c_status_t i2c_start_write(uint8_t addr7);
 i2c_status_t i2c_start_read(uint8_t addr7);
 i2c_status_t i2c_restart_write(uint8_t addr7);
 i2c_status_t i2c_restart_read(uint8_t addr7);
 
-void i2c_stop(void);
+i2c_status_t i2c_stop(void);    // I2C_TIMEOUT_ERR if the STOP never completed
 
 i2c_status_t i2c_write(uint8_t data);
 
 i2c_status_t i2c_read_ack(uint8_t *out);
 i2c_status_t i2c_read_nack(uint8_t *out);
 
-// Helpers 
+// Helpers (blocking wrappers around the async engine)
 i2c_status_t i2c_write_bytes(uint8_t addr7, const uint8_t *data, uint16_t len);
 i2c_status_t i2c_read_bytes(uint8_t addr7, uint8_t *data, uint16_t len);
 
 i2c_status_t i2c_write_reg(uint8_t addr7, uint8_t reg, const uint8_t *data, uint16_t len);
 i2c_status_t i2c_read_reg(uint8_t addr7, uint8_t reg, uint8_t *data, uint16_t len);
 
+// Device helpers: dev clock, dev->reg_width address bytes, retried on NACK
+i2c_status_t i2c_device_init(i2c_device_t *dev, uint8_t addr7, uint32_t scl_hz,
+                             uint8_t reg_width, uint8_t retries);
+i2c_status_t i2c_dev_write(const i2c_device_t *dev, const uint8_t *data, uint16_t len);
+i2c_status_t i2c_dev_read(const i2c_device_t *dev, uint8_t *data, uint16_t len);
+i2c_status_t i2c_dev_write_reg(const i2c_device_t *dev, uint16_t reg, const uint8_t *data, uint16_t len);
+i2c_status_t i2c_dev_read_reg(const i2c_device_t *dev, uint16_t reg, uint8_t *data, uint16_t len);
+
 #endif
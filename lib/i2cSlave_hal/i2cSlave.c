@@ -0,0 +1,274 @@
+// TWI slave: register file behind SR/ST status codes (ATmega328P datasheet, 22.7.3/22.7.4)
+//   1) Address match:
+//      - TWAR = addr7 << 1 | TWGCE, TWAMR = addr_mask << 1. TWEA = 1 keeps the address
+//        recognition on; it is only cleared for one byte to NACK a non-writable register.
+//
+//   2) Receive (SR):
+//      - First data byte after SLA+W is the register pointer, the rest go to regs[ptr++].
+//      - TWEA for the *next* byte is decided now, from whether ptr is writable; a NACKed byte
+//        (0x88/0x98) drops the TWI to "not addressed", so TWEA is set again right after it.
+//      - 0xA0 (STOP or REPEATED START while addressed) or a NACKed byte closes the write and
+//        calls on_write.
+//
+//   3) Transmit (ST):
+//      - TWDR is loaded in the same ISR run that acknowledges SLA+R / the previous byte, so
+//        the host only waits for ISR latency, never for the main loop.
+//      - SLA+R copies I2C_SLAVE_LATCH registers from the pointer into slv_latch and the
+//        first bytes are served from there: each byte costs one TWI_vect, and an
+//        i2c_slave_set() between two of them must not mix old and new bytes of a value.
+//        The pointer still advances per byte sent, so a short read leaves it where it was.
+//
+//   4) Errors:
+//      - Bus error (0x00): TWSTO + TWINT releases the lines and resets the TWI (no STOP sent).
+
+#include "i2cSlave.h"
+#include <avr/interrupt.h>
+
+#if (I2C_SLAVE_LATCH < 1) || (I2C_SLAVE_LATCH > 32)
+#error "I2C_SLAVE_LATCH must be in 1..32"
+#endif
+
+// --------- TWI status codes (slave) ----------
+#define TW_STATUS_MASK 0xF8
+
+// Slave Receiver
+#define TW_SR_SLA_ACK            0x60
+#define TW_SR_ARB_LOST_SLA_ACK   0x68
+#define TW_SR_GCALL_ACK          0x70
+#define TW_SR_ARB_LOST_GCALL_ACK 0x78
+#define TW_SR_DATA_ACK           0x80
+#define TW_SR_DATA_NACK          0x88
+#define TW_SR_GCALL_DATA_ACK     0x90
+#define TW_SR_GCALL_DATA_NACK    0x98
+#define TW_SR_STOP               0xA0
+
+// Slave Transmitter
+#define TW_ST_SLA_ACK            0xA8
+#define TW_ST_ARB_LOST_SLA_ACK   0xB0
+#define TW_ST_DATA_ACK           0xB8
+#define TW_ST_DATA_NACK          0xC0
+#define TW_ST_LAST_DATA          0xC8
+
+// Misc
+#define TW_BUS_ERROR             0x00
+
+#define TWCR_ACK  ((1 << TWINT) | (1 << TWEN) | (1 << TWIE) | (1 << TWEA))
+#define TWCR_NACK ((1 << TWINT) | (1 << TWEN) | (1 << TWIE))
+
+// Copied from the config so the ISR works on plain statics
+static volatile uint8_t *slv_regs;
+static uint16_t slv_size;
+static uint8_t slv_rd_first, slv_rd_last;
+static uint8_t slv_wr_first, slv_wr_last;
+static i2c_slave_write_cb_t slv_on_write;
+
+// Transaction state (ISR only)
+static uint8_t slv_ptr;         // register pointer, auto-increment
+static bool slv_have_ptr;       // first byte of this write already taken as pointer
+static uint8_t slv_wr_start;    // first register written in this transaction
+static uint8_t slv_wr_count;
+static volatile bool slv_busy;
+static uint8_t slv_latch[I2C_SLAVE_LATCH];
+static uint8_t slv_latch_i;     // next latched byte to send
+
+static inline bool slv_writable(uint8_t reg)
+{
+    return reg < slv_size && reg >= slv_wr_first && reg <= slv_wr_last;
+}
+
+static inline uint8_t slv_read_reg(uint8_t reg)
+{
+    if (reg < slv_size && reg >= slv_rd_first && reg <= slv_rd_last)
+        return slv_regs[reg];
+    return 0xFF;
+}
+
+// Snapshot of the registers a read starting at slv_ptr will send first
+static inline void slv_latch_fill(void)
+{
+    uint8_t reg = slv_ptr;
+    for (uint8_t i = 0; i < I2C_SLAVE_LATCH; i++)
+        slv_latch[i] = slv_read_reg(reg++);
+    slv_latch_i = 0;
+}
+
+static inline uint8_t slv_read_next(void)
+{
+    uint8_t reg = slv_ptr++;
+    if (slv_latch_i < I2C_SLAVE_LATCH)
+        return slv_latch[slv_latch_i++];
+    return slv_read_reg(reg);
+}
+
+// End of a write (STOP / REPEATED START): report what changed
+static inline void slv_write_done(void)
+{
+    if (slv_wr_count && slv_on_write)
+        slv_on_write(slv_wr_start, slv_wr_count);
+    slv_wr_count = 0;
+}
+
+ISR(TWI_vect)
+{
+    switch (TWSR & TW_STATUS_MASK)
+    {
+    // ----- Slave Receiver -----
+    case TW_SR_SLA_ACK:
+    case TW_SR_ARB_LOST_SLA_ACK:
+    case TW_SR_GCALL_ACK:
+    case TW_SR_ARB_LOST_GCALL_ACK:
+        slv_busy = true;
+        slv_have_ptr = false;
+        slv_wr_count = 0;
+        TWCR = TWCR_ACK; // always take the register pointer
+        break;
+
+    case TW_SR_DATA_ACK:
+    case TW_SR_GCALL_DATA_ACK:
+    {
+        uint8_t b = TWDR;
+        if (!slv_have_ptr)
+        {
+            slv_ptr = b;
+            slv_have_ptr = true;
+        }
+        else
+        {
+            // ACKed, so writable (checked when TWEA was chosen)
+            if (slv_wr_count == 0)
+                slv_wr_start = slv_ptr;
+            slv_regs[slv_ptr++] = b;
+            slv_wr_count++;
+        }
+        TWCR = slv_writable(slv_ptr) ? TWCR_ACK : TWCR_NACK;
+        break;
+    }
+
+    case TW_SR_DATA_NACK:
+    case TW_SR_GCALL_DATA_NACK:
+        // Byte refused and the TWI is no longer addressed: no 0xA0 will follow
+        slv_write_done();
+        slv_busy = false;
+        TWCR = TWCR_ACK;
+        break;
+
+    case TW_SR_STOP:
+        slv_write_done();
+        slv_busy = false;
+        TWCR = TWCR_ACK;
+        break;
+
+    // ----- Slave Transmitter -----
+    case TW_ST_SLA_ACK:
+    case TW_ST_ARB_LOST_SLA_ACK:
+        slv_busy = true;
+        slv_write_done(); // normally already closed by 0xA0; harmless if so
+        slv_latch_fill();
+        TWDR = slv_read_next();
+        TWCR = TWCR_ACK;
+        break;
+
+    case TW_ST_DATA_ACK:
+        TWDR = slv_read_next();
+        TWCR = TWCR_ACK;
+        break;
+
+    case TW_ST_DATA_NACK:   // host ended the read
+    case TW_ST_LAST_DATA:
+        slv_busy = false;
+        TWCR = TWCR_ACK;
+        break;
+
+    // ----- Errors -----
+    case TW_BUS_ERROR:
+        slv_wr_count = 0;
+        slv_busy = false;
+        TWCR = TWCR_ACK | (1 << TWSTO);
+        break;
+
+    default:
+        TWCR = TWCR_ACK;
+        break;
+    }
+}
+
+i2c_slave_status_t i2c_slave_init(const i2c_slave_config_t *cfg)
+{
+    if (!cfg || !cfg->regs || cfg->size == 0 || cfg->size > 256 ||
+        cfg->addr7 == 0 || cfg->addr7 > 0x7F)
+        return I2C_SLAVE_ERR_PARAM;
+
+    uint8_t sreg = SREG;
+    cli();
+
+    TWCR = 0; // stop serving while the map changes
+
+    slv_regs = cfg->regs;
+    slv_size = cfg->size;
+    slv_rd_first = cfg->rd_first;
+    slv_rd_last = cfg->rd_last;
+    slv_wr_first = cfg->wr_first;
+    slv_wr_last = cfg->wr_last;
+    slv_on_write = cfg->on_write;
+    slv_ptr = 0;
+    slv_have_ptr = false;
+    slv_wr_count = 0;
+    slv_busy = false;
+
+    // SDA/SCL pull-ups are a board-level requirement (as in the master driver)
+    PRR &= (uint8_t)~(1 << PRTWI);
+    TWAR = (uint8_t)((cfg->addr7 << 1) | (cfg->general_call ? (1 << TWGCE) : 0));
+    TWAMR = (uint8_t)(cfg->addr_mask << 1);
+    TWCR = (1 << TWEN) | (1 << TWIE) | (1 << TWEA);
+
+    SREG = sreg;
+    return I2C_SLAVE_OK;
+}
+
+void i2c_slave_deinit(void)
+{
+    uint8_t sreg = SREG;
+    cli();
+    TWCR = 0; // releases SDA/SCL
+    TWAR = 0;
+    TWAMR = 0;
+    slv_busy = false;
+    PRR |= (1 << PRTWI); // power-gate TWI until the next init
+    SREG = sreg;
+}
+
+i2c_slave_status_t i2c_slave_set(uint8_t reg, const uint8_t *data, uint8_t len)
+{
+    if (!slv_regs || (!data && len) || (uint16_t)reg + len > slv_size)
+        return I2C_SLAVE_ERR_PARAM;
+
+    uint8_t sreg = SREG;
+    cli();
+    for (uint8_t i = 0; i < len; i++)
+        slv_regs[reg + i] = data[i];
+    SREG = sreg;
+    return I2C_SLAVE_OK;
+}
+
+i2c_slave_status_t i2c_slave_get(uint8_t reg, uint8_t *data, uint8_t len)
+{
+    if (!slv_regs || (!data && len) || (uint16_t)reg + len > slv_size)
+        return I2C_SLAVE_ERR_PARAM;
+
+    uint8_t sreg = SREG;
+    cli();
+    if (slv_wr_count)
+    {
+        SREG = sreg;
+        return I2C_SLAVE_ERR_BUSY; // part of a host write: on_write will follow
+    }
+    for (uint8_t i = 0; i < len; i++)
+        data[i] = slv_regs[reg + i];
+    SREG = sreg;
+    return I2C_SLAVE_OK;
+}
+
+bool i2c_slave_busy(void)
+{
+    return slv_busy;
+}
@@ -0,0 +1,61 @@
+#ifndef I2C_SLAVE_H
+#define I2C_SLAVE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <avr/io.h>
+
+// TWI slave with a memory-mapped register file, served entirely from TWI_vect.
+// Protocol (common sensor/EEPROM style):
+//   write: START, SLA+W, reg, data..., STOP      -> regs[reg], regs[reg+1], ...
+//   read:  START, SLA+W, reg, RESTART, SLA+R, data..., STOP
+//          (or just SLA+R: continues from the current register pointer)
+// The pointer auto-increments on every byte. Writes outside the writable range
+// are NACKed; reads outside the readable range (or past size) return 0xFF.
+//
+// The hardware stretches SCL only for as long as TWI_vect takes to run; the
+// main loop is never on the reply path.
+//
+// Both this driver and lib/i2cMaster_hal define TWI_vect: an application links
+// one or the other, never both.
+
+#ifndef I2C_SLAVE_LATCH
+#define I2C_SLAVE_LATCH 4       // bytes snapshotted at SLA+R, 1..32
+#endif
+
+typedef enum {
+    I2C_SLAVE_OK = 0,
+    I2C_SLAVE_ERR_PARAM,
+    I2C_SLAVE_ERR_BUSY          // i2c_slave_get(): host write in progress, retry later
+} i2c_slave_status_t;
+
+// Host finished writing (STOP or REPEATED START): first register and byte count.
+// Runs in ISR context.
+typedef void (*i2c_slave_write_cb_t)(uint8_t first_reg, uint8_t count);
+
+typedef struct {
+    uint8_t addr7;
+    uint8_t addr_mask;          // TWAMR: address bits to ignore (0 = exact match)
+    bool general_call;          // also accept writes to address 0x00
+    volatile uint8_t *regs;     // register file (owned by the application)
+    uint16_t size;              // 1..256 registers
+    uint8_t rd_first, rd_last;  // host-readable registers, inclusive
+    uint8_t wr_first, wr_last;  // host-writable registers, inclusive (first > last: none)
+    i2c_slave_write_cb_t on_write; // optional
+} i2c_slave_config_t;
+
+i2c_slave_status_t i2c_slave_init(const i2c_slave_config_t *cfg);
+void i2c_slave_deinit(void);
+
+// Copy to/from the register file with TWI_vect masked.
+// A host read serves its first I2C_SLAVE_LATCH bytes from a copy taken at SLA+R,
+// so a value of up to I2C_SLAVE_LATCH bytes read in one transaction is never
+// half-updated by i2c_slave_set(). i2c_slave_get() refuses (ERR_BUSY) while a
+// host write has stored bytes that on_write has not reported yet.
+i2c_slave_status_t i2c_slave_set(uint8_t reg, const uint8_t *data, uint8_t len);
+i2c_slave_status_t i2c_slave_get(uint8_t reg, uint8_t *data, uint8_t len);
+
+bool i2c_slave_busy(void);      // addressed by the host right now
+
+#endif
@@ -0,0 +1,212 @@
+// Cycle profiler internals:
+//   1) Clock:
+//      - Timer1 normal mode at clk/1; TIMER1_OVF_vect counts the high 16 bits.
+//      - prof_now() runs with interrupts off. An overflow that happened after cli() is still
+//        pending (TOV1 set): if TCNT1 was read as a small value it belongs to the new period,
+//        so the high word is taken one ahead (same trick as the timebase's TOV0 catch-up).
+//
+//   2) Recording:
+//      - prof_end() reads the clock first, then updates the site under cli(): the markers can
+//        run in ISRs and main alike, and a record is never seen half written.
+//      - Overhead: prof_init() times empty begin/end pairs (call + clock read) under cli()
+//        and every sample is reduced by the shortest, so an empty section reads ~0 cycles.
+
+#include "prof.h"
+
+#if PROF_ENABLE
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#if (PROF_SITES < 1) || (PROF_SITES > 8)
+#error "PROF_SITES must be in 1..8"
+#endif
+#if (PROF_BUCKETS < 1) || (PROF_BUCKETS > 32)
+#error "PROF_BUCKETS must be in 1..32"
+#endif
+
+#define PROF_CAL_RUNS 8
+
+static volatile uint16_t prof_hi;   // written by ISR
+static uint32_t prof_start[PROF_SITES];
+static uint8_t prof_open;           // bit id: begin seen, end pending
+static uint32_t prof_overhead;      // cycles of an empty begin/end pair
+static prof_site_t prof_site[PROF_SITES];
+
+ISR(TIMER1_OVF_vect)
+{
+    prof_hi++;
+}
+
+// 32-bit cycle count (interrupts off)
+static inline uint32_t prof_now(void)
+{
+    uint16_t lo = TCNT1;
+    uint16_t hi = prof_hi;
+    if ((TIFR1 & (1 << TOV1)) && lo < 0x8000)
+        hi++; // overflow pending, not counted yet
+    return ((uint32_t)hi << 16) | lo;
+}
+
+// floor(log2(v)), 0 for v <= 1
+static inline uint8_t prof_log2(uint32_t v)
+{
+    uint8_t b = 0;
+    if (v >> 16) { b += 16; v >>= 16; }
+    if (v >> 8)  { b += 8;  v >>= 8; }
+    if (v >> 4)  { b += 4;  v >>= 4; }
+    if (v >> 2)  { b += 2;  v >>= 2; }
+    if (v >> 1)  { b += 1; }
+    return b;
+}
+
+// Interrupts off
+static void prof_record(prof_site_t *s, uint32_t c)
+{
+    s->count++;
+    if (c < s->min)
+        s->min = c;
+    if (c > s->max)
+        s->max = c;
+    s->total = (s->total + c < s->total) ? 0xFFFFFFFFUL : s->total + c;
+
+    uint8_t b = prof_log2(c);
+    if (b >= PROF_BUCKETS)
+        b = PROF_BUCKETS - 1;
+    if (s->hist[b] != 0xFFFF)
+        s->hist[b]++;
+}
+
+static void prof_clear(void)
+{
+    for (uint8_t i = 0; i < PROF_SITES; i++)
+    {
+        prof_site_t *s = &prof_site[i];
+        s->count = 0;
+        s->min = 0xFFFFFFFFUL;
+        s->max = 0;
+        s->total = 0;
+        for (uint8_t b = 0; b < PROF_BUCKETS; b++)
+            s->hist[b] = 0;
+    }
+    prof_open = 0;
+}
+
+void prof_init(void)
+{
+    PRR &= (uint8_t)~(1 << PRTIM1);
+
+    uint8_t sreg = SREG;
+    cli();
+    TCCR1B = 0;
+    TCCR1A = 0;             // normal mode, OC1A/OC1B disconnected
+    TCNT1 = 0;
+    prof_hi = 0;
+    TIFR1 = (1 << TOV1);
+    TIMSK1 = (1 << TOIE1);
+    TCCR1B = (1 << CS10);   // clk/1
+
+    // Calibrate on site 0 with nothing in between: interrupts stay off so no ISR
+    // lands inside a pair, and the minimum of several pairs is kept
+    prof_overhead = 0;
+    prof_clear();
+    for (uint8_t i = 0; i < PROF_CAL_RUNS; i++)
+    {
+        prof_begin(0);
+        prof_end(0);
+    }
+    prof_overhead = prof_site[0].min;
+    prof_clear();
+    SREG = sreg;
+}
+
+uint32_t prof_cycles(void)
+{
+    uint8_t sreg = SREG;
+    cli();
+    uint32_t now = prof_now();
+    SREG = sreg;
+    return now;
+}
+
+void prof_begin(uint8_t id)
+{
+    if (id >= PROF_SITES)
+        return;
+
+    uint8_t sreg = SREG;
+    cli();
+    prof_open |= (uint8_t)(1 << id);
+    prof_start[id] = prof_now(); // last: the section starts right after this
+    SREG = sreg;
+}
+
+void prof_end(uint8_t id)
+{
+    uint8_t sreg = SREG;
+    cli();
+    uint32_t now = prof_now(); // first: the section ended right before this
+    if (id < PROF_SITES && (prof_open & (1 << id)))
+    {
+        prof_open &= (uint8_t)~(1 << id);
+        uint32_t c = now - prof_start[id];
+        prof_record(&prof_site[id], c > prof_overhead ? c - prof_overhead : 0);
+    }
+    SREG = sreg;
+}
+
+bool prof_get(uint8_t id, prof_site_t *out)
+{
+    if (id >= PROF_SITES || !out)
+        return false;
+
+    uint8_t sreg = SREG;
+    cli();
+    *out = prof_site[id];
+    SREG = sreg;
+    return true;
+}
+
+void prof_reset(void)
+{
+    uint8_t sreg = SREG;
+    cli();
+    prof_clear();
+    SREG = sreg;
+}
+
+uart_status_t prof_dump(uint32_t timeout)
+{
+    uart_status_t st = UART_OK;
+    for (uint8_t id = 0; id < PROF_SITES && st == UART_OK; id++)
+    {
+        prof_site_t s;
+        prof_get(id, &s);
+        if (s.count == 0)
+            continue;
+
+        uart0_write_u32(id, timeout);
+        UART0_PRINT(" n=", timeout);
+        uart0_write_u32(s.count, timeout);
+        UART0_PRINT(" min=", timeout);
+        uart0_write_u32(s.min, timeout);
+        UART0_PRINT(" avg=", timeout);
+        uart0_write_u32(s.total / s.count, timeout);
+        UART0_PRINT(" max=", timeout);
+        uart0_write_u32(s.max, timeout);
+        UART0_PRINT(" |", timeout);
+        for (uint8_t b = 0; b < PROF_BUCKETS; b++)
+        {
+            if (!s.hist[b])
+                continue;
+            uart0_write_byte(' ', timeout);
+            uart0_write_u32(b, timeout);
+            uart0_write_byte(':', timeout);
+            uart0_write_u32(s.hist[b], timeout);
+        }
+        st = uart0_write_line_P(UART0_STR(""), timeout);
+    }
+    return st;
+}
+
+#endif
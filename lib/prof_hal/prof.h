@@ -0,0 +1,65 @@
+#ifndef PROF_H
+#define PROF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart0.h"
+
+// Cycle profiler on Timer1 (normal mode, clk/1: one tick = one CPU cycle).
+// TIMER1_OVF_vect extends TCNT1 to 32 bits (wraps after ~268 s @16 MHz).
+// prof_begin(id) / prof_end(id) bracket a code path; every pair updates the
+// site's count, min, max and a log2 histogram (bucket b: 2^b .. 2^(b+1)-1
+// cycles, the last bucket takes everything longer). The cost of an empty
+// begin/end pair is measured by prof_init() and subtracted.
+//
+// Timer1 is owned while profiling: no Timer1 PWM (pwm_timer1_*, D9/D10) and
+// no ADC Timer1 auto-triggers. Both markers are safe in ISRs; one id must not
+// be open in two contexts at once (the later begin wins).
+//
+// -DPROF_ENABLE=0 turns the markers into empty inlines (no Timer1, no SRAM).
+
+#ifndef PROF_ENABLE
+#define PROF_ENABLE 1
+#endif
+
+#ifndef PROF_SITES
+#define PROF_SITES 4            // ids 0..PROF_SITES-1, at most 8
+#endif
+
+#ifndef PROF_BUCKETS
+#define PROF_BUCKETS 16         // 2^15+ cycles (>= 2 ms @16 MHz) in the last bucket
+#endif
+
+#define PROF_CYCLES_TO_US(c) ((uint32_t)(c) / (F_CPU / 1000000UL))
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;               // cycles, 0xFFFFFFFF before the first sample
+    uint32_t max;
+    uint32_t total;             // cycles, saturates (avg = total / count)
+    uint16_t hist[PROF_BUCKETS]; // saturating
+} prof_site_t;
+
+#if PROF_ENABLE
+void     prof_init(void);       // Timer1 on, calibrate, clear all sites
+uint32_t prof_cycles(void);     // 32-bit cycle counter
+void     prof_begin(uint8_t id);
+void     prof_end(uint8_t id);  // ignored without a matching begin
+
+bool prof_get(uint8_t id, prof_site_t *out);  // atomic copy, false for a bad id
+void prof_reset(void);
+
+// One text line per used site, in cycles:
+//   "<id> n=<count> min=.. avg=.. max=.. | <bucket>:<count> ..."
+uart_status_t prof_dump(uint32_t timeout);
+#else
+static inline void     prof_init(void) {}
+static inline uint32_t prof_cycles(void) { return 0; }
+static inline void     prof_begin(uint8_t id) { (void)id; }
+static inline void     prof_end(uint8_t id) { (void)id; }
+static inline bool     prof_get(uint8_t id, prof_site_t *out) { (void)id; (void)out; return false; }
+static inline void     prof_reset(void) {}
+static inline uart_status_t prof_dump(uint32_t timeout) { (void)timeout; return UART_OK; }
+#endif
+
+#endif
@@ -0,0 +1,255 @@
+// Output compare PWM (ATmega328P datasheet 15/16/18):
+//   1) Waveform modes:
+//      - Timer0: mode 3 (fast, TOP = 0xFF), set up by the timebase; only COM0x/OCR0x are ours.
+//      - Timer1: mode 14 (fast, TOP = ICR1) or mode 8 (phase and frequency correct, TOP = ICR1).
+//      - Timer2: mode 3 (fast, TOP = 0xFF) or mode 1 (phase correct, TOP = 0xFF).
+//
+//   2) Extreme duty values:
+//      - OCR = TOP gives a constant high in every mode.
+//      - OCR = 0 in fast PWM still gives a one-tick spike per period, so a 0 duty disconnects
+//        the COM bits instead (PORT bit is low) and the next non-zero duty reconnects them.
+//
+//   3) 16-bit registers:
+//      - OCR1x/ICR1 go through the shared TEMP byte, so every 16-bit write runs under cli().
+
+#include "pwm.h"
+#include "timebase.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+typedef struct {
+    gpio_pin_t pin;
+    uint8_t timer;                  // 0, 1, 2
+    volatile uint8_t *tccra;
+    uint8_t com;                    // COMnx1 (non-inverting)
+    volatile uint8_t *ocr8;         // Timer0/2
+    volatile uint16_t *ocr16;       // Timer1
+} pwm_map_t;
+
+static const pwm_map_t pwm_map[] = {
+    { PIN_D6,  0, &TCCR0A, (1 << COM0A1), &OCR0A, 0 },
+    { PIN_D5,  0, &TCCR0A, (1 << COM0B1), &OCR0B, 0 },
+    { PIN_D9,  1, &TCCR1A, (1 << COM1A1), 0, &OCR1A },
+    { PIN_D10, 1, &TCCR1A, (1 << COM1B1), 0, &OCR1B },
+    { PIN_D11, 2, &TCCR2A, (1 << COM2A1), &OCR2A, 0 },
+    { PIN_D3,  2, &TCCR2A, (1 << COM2B1), &OCR2B, 0 },
+};
+
+#define PWM_CHANNELS (sizeof(pwm_map) / sizeof(pwm_map[0]))
+
+static uint8_t pwm_attached;        // bit i = pwm_map[i]
+static pwm_mode_t pwm_t1_mode;
+static pwm_mode_t pwm_t2_mode;
+static bool pwm_t1_ready;
+static bool pwm_t2_ready;
+
+static const pwm_map_t *pwm_lookup(gpio_pin_t pin, uint8_t *index)
+{
+    for (uint8_t i = 0; i < PWM_CHANNELS; i++)
+    {
+        if (pwm_map[i].pin == pin)
+        {
+            *index = i;
+            return &pwm_map[i];
+        }
+    }
+    return 0;
+}
+
+// Prescaler -> CSn2:0 (0 = unsupported)
+static uint8_t pwm_cs_t1(uint16_t n)
+{
+    switch (n)
+    {
+    case 1:    return 1;
+    case 8:    return 2;
+    case 64:   return 3;
+    case 256:  return 4;
+    case 1024: return 5;
+    default:   return 0;
+    }
+}
+
+static uint8_t pwm_cs_t2(uint16_t n)
+{
+    switch (n)
+    {
+    case 1:    return 1;
+    case 8:    return 2;
+    case 32:   return 3;
+    case 64:   return 4;
+    case 128:  return 5;
+    case 256:  return 6;
+    case 1024: return 7;
+    default:   return 0;
+    }
+}
+
+static uint16_t pwm_timer_top(uint8_t timer)
+{
+    if (timer != 1)
+        return 0xFF;
+
+    uint8_t sreg = SREG;
+    cli();
+    uint16_t top = ICR1;
+    SREG = sreg;
+    return top;
+}
+
+// ----------------- Timers -----------------
+pwm_status_t pwm_timer1_init(pwm_mode_t mode, uint16_t prescaler, uint16_t top)
+{
+    uint8_t cs = pwm_cs_t1(prescaler);
+    if (!cs || top < 3 || mode > PWM_PHASE_CORRECT)
+        return PWM_ERR_PARAM;
+
+    PRR &= (uint8_t)~(1 << PRTIM1);
+
+    uint8_t sreg = SREG;
+    cli();
+    TCCR1B = 0; // stop while reconfiguring
+    // Keep the COM bits of attached outputs, replace WGM11:10
+    TCCR1A = (uint8_t)((TCCR1A & 0xF0) | (mode == PWM_FAST ? (1 << WGM11) : 0));
+    ICR1 = top;
+    TCNT1 = 0;
+    TCCR1B = (uint8_t)((mode == PWM_FAST ? ((1 << WGM13) | (1 << WGM12)) : (1 << WGM13)) | cs);
+    pwm_t1_mode = mode;
+    pwm_t1_ready = true;
+    SREG = sreg;
+    return PWM_OK;
+}
+
+pwm_status_t pwm_timer1_set_freq(pwm_mode_t mode, uint32_t hz)
+{
+    static const uint16_t n_list[] = { 1, 8, 64, 256, 1024 };
+    if (hz == 0 || mode > PWM_PHASE_CORRECT)
+        return PWM_ERR_PARAM;
+
+    // Smallest prescaler whose TOP fits 16 bits = finest duty resolution
+    for (uint8_t i = 0; i < sizeof(n_list) / sizeof(n_list[0]); i++)
+    {
+        uint32_t ticks = (uint32_t)n_list[i] * hz * (mode == PWM_FAST ? 1UL : 2UL);
+        uint32_t top = (F_CPU + ticks / 2UL) / ticks; // rounded F_CPU / ticks
+        if (mode == PWM_FAST)
+            top -= 1UL;
+        if (top <= 0xFFFFUL)
+            return top >= 3UL ? pwm_timer1_init(mode, n_list[i], (uint16_t)top) : PWM_ERR_PARAM;
+    }
+    return PWM_ERR_PARAM; // below ~0.12 Hz
+}
+
+pwm_status_t pwm_timer2_init(pwm_mode_t mode, uint16_t prescaler)
+{
+    uint8_t cs = pwm_cs_t2(prescaler);
+    if (!cs || mode > PWM_PHASE_CORRECT)
+        return PWM_ERR_PARAM;
+
+    PRR &= (uint8_t)~(1 << PRTIM2);
+
+    uint8_t sreg = SREG;
+    cli();
+    TCCR2B = 0;
+    TCCR2A = (uint8_t)((TCCR2A & 0xF0) |
+                       (mode == PWM_FAST ? ((1 << WGM21) | (1 << WGM20)) : (1 << WGM20)));
+    TCNT2 = 0;
+    TCCR2B = cs;
+    pwm_t2_mode = mode;
+    pwm_t2_ready = true;
+    SREG = sreg;
+    return PWM_OK;
+}
+
+// ----------------- Outputs -----------------
+pwm_status_t pwm_attach(gpio_pin_t pin)
+{
+    uint8_t i;
+    const pwm_map_t *m = pwm_lookup(pin, &i);
+    if (!m)
+        return PWM_ERR_PIN;
+
+    if (m->timer == 0)
+        timebase_init(); // Timer0 is the timebase: already in fast PWM
+    else if ((m->timer == 1 && !pwm_t1_ready) || (m->timer == 2 && !pwm_t2_ready))
+        return PWM_ERR_PARAM;
+
+    // Duty 0: pin low, COM disconnected until the first pwm_write()
+    gpio_write(pin, GPIO_LOW);
+    gpio_pin_mode(pin, GPIO_OUTPUT);
+
+    uint8_t sreg = SREG;
+    cli();
+    *(m->tccra) &= (uint8_t)~m->com;
+    if (m->ocr16)
+        *(m->ocr16) = 0;
+    else
+        *(m->ocr8) = 0;
+    pwm_attached |= (uint8_t)(1 << i);
+    SREG = sreg;
+    return PWM_OK;
+}
+
+pwm_status_t pwm_detach(gpio_pin_t pin)
+{
+    uint8_t i;
+    const pwm_map_t *m = pwm_lookup(pin, &i);
+    if (!m)
+        return PWM_ERR_PIN;
+
+    uint8_t sreg = SREG;
+    cli();
+    *(m->tccra) &= (uint8_t)~m->com; // PORT bit (low) drives the pin again
+    pwm_attached &= (uint8_t)~(1 << i);
+    SREG = sreg;
+    return PWM_OK;
+}
+
+pwm_status_t pwm_write(gpio_pin_t pin, uint16_t value)
+{
+    uint8_t i;
+    const pwm_map_t *m = pwm_lookup(pin, &i);
+    if (!m)
+        return PWM_ERR_PIN;
+    if (!(pwm_attached & (1 << i)))
+        return PWM_ERR_PARAM;
+
+    uint16_t top = pwm_timer_top(m->timer);
+    if (value > top)
+        value = top;
+
+    pwm_mode_t mode = m->timer == 1 ? pwm_t1_mode : m->timer == 2 ? pwm_t2_mode : PWM_FAST;
+
+    uint8_t sreg = SREG;
+    cli();
+    if (m->ocr16)
+        *(m->ocr16) = value;
+    else
+        *(m->ocr8) = (uint8_t)value;
+
+    if (value == 0 && mode == PWM_FAST)
+        *(m->tccra) &= (uint8_t)~m->com; // avoid the BOTTOM spike
+    else
+        *(m->tccra) |= m->com;
+    SREG = sreg;
+    return PWM_OK;
+}
+
+pwm_status_t pwm_write_scaled(gpio_pin_t pin, uint16_t duty)
+{
+    uint8_t i;
+    const pwm_map_t *m = pwm_lookup(pin, &i);
+    if (!m)
+        return PWM_ERR_PIN;
+
+    // 0xFFFF -> TOP (full on), 0 -> 0
+    uint32_t top = pwm_timer_top(m->timer);
+    uint16_t value = (duty == 0xFFFF) ? (uint16_t)top : (uint16_t)(((uint32_t)duty * (top + 1UL)) >> 16);
+    return pwm_write(pin, value);
+}
+
+uint16_t pwm_top(gpio_pin_t pin)
+{
+    uint8_t i;
+    const pwm_map_t *m = pwm_lookup(pin, &i);
+    return m ? pwm_timer_top(m->timer) : 0;
+}
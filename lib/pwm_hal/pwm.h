@@ -0,0 +1,49 @@
+#ifndef PWM_H
+#define PWM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "gpio.h"
+
+// Hardware PWM on the output-compare pins of the pin map:
+//   PIN_D6 = OC0A, PIN_D5 = OC0B   Timer0: shared with the timebase, fixed fast PWM,
+//                                  TOP = 255, clk/64 (976 Hz @16 MHz)
+//   PIN_D9 = OC1A, PIN_D10 = OC1B  Timer1: 16-bit, TOP = ICR1 (exact frequencies)
+//   PIN_D11 = OC2A, PIN_D3 = OC2B  Timer2: 8-bit, TOP = 255
+// D10/D11 are also SPI SS/MOSI: no Timer1-B / Timer2-A PWM while the SPI master runs.
+// Timer1 is also the cycle profiler clock (prof_hal): not both in one build.
+//
+// Once attached the waveform needs no CPU. Compare values are double-buffered
+// by the timer (loaded at TOP/BOTTOM), so duty updates never produce a
+// truncated or doubled pulse.
+
+typedef enum {
+    PWM_OK = 0,
+    PWM_ERR_PARAM,
+    PWM_ERR_PIN         // not an OCxx pin
+} pwm_status_t;
+
+typedef enum {
+    PWM_FAST = 0,       // single slope: f = F_CPU / (N * (TOP + 1))
+    PWM_PHASE_CORRECT   // dual slope, symmetric pulses: f = F_CPU / (2 * N * TOP)
+} pwm_mode_t;
+
+// ---------- Timers ----------
+// prescaler N: Timer1 1/8/64/256/1024, Timer2 1/8/32/64/128/256/1024.
+// Timer1 phase-correct uses "phase and frequency correct" (mode 8): ICR1 is
+// buffered too, so TOP can change on the fly. In fast mode (14) ICR1 is not
+// buffered; change the frequency while the outputs are detached or accept one
+// irregular period.
+pwm_status_t pwm_timer1_init(pwm_mode_t mode, uint16_t prescaler, uint16_t top); // top >= 3
+pwm_status_t pwm_timer1_set_freq(pwm_mode_t mode, uint32_t hz); // picks N and TOP (best resolution)
+pwm_status_t pwm_timer2_init(pwm_mode_t mode, uint16_t prescaler);
+
+// ---------- Outputs ----------
+pwm_status_t pwm_attach(gpio_pin_t pin);        // output, non-inverting, duty 0
+pwm_status_t pwm_detach(gpio_pin_t pin);        // back to a plain GPIO (driven low)
+
+pwm_status_t pwm_write(gpio_pin_t pin, uint16_t value); // raw compare value, clamped to TOP
+pwm_status_t pwm_write_scaled(gpio_pin_t pin, uint16_t duty); // 0..65535 of the period
+uint16_t     pwm_top(gpio_pin_t pin);           // TOP of the pin's timer, 0 for a bad pin
+
+#endif
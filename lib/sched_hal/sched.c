@@ -0,0 +1,172 @@
+// Scheduler internals:
+//   1) Ready sources:
+//      - posted: one volatile byte per task, only ever set by sched_post() and cleared by
+//        the loop, so ISRs need no cli(). sched_flag ("something was posted") lets the idle
+//        check look at one byte instead of the whole table.
+//      - timers: due/period on the time_ms() clock, owned by the main context.
+//
+//   2) Idle:
+//      - cli(), re-check sched_flag, then sleep_enable/sei/sleep_cpu: SEI delays interrupts
+//        by one instruction, so a post landing after the check still wakes the CPU.
+
+#include "sched.h"
+#include "timebase.h"
+#include <stddef.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+typedef struct {
+    sched_fn_t fn;              // NULL = free slot
+    void *arg;
+    uint32_t due;               // time_ms() of the next timed run
+    uint32_t period;            // 0 = one-shot
+    bool timed;
+    volatile uint8_t posted;
+} sched_task_t;
+
+static sched_task_t sched_tasks[SCHED_MAX_TASKS];
+static volatile uint8_t sched_flag;
+
+void sched_init(void)
+{
+    timebase_init();
+    for (uint8_t i = 0; i < SCHED_MAX_TASKS; i++)
+    {
+        sched_tasks[i].fn = NULL;
+        sched_tasks[i].timed = false;
+        sched_tasks[i].posted = 0;
+    }
+    sched_flag = 0;
+}
+
+sched_id_t sched_add(sched_fn_t fn, void *arg)
+{
+    if (!fn)
+        return SCHED_INVALID;
+
+    for (uint8_t i = 0; i < SCHED_MAX_TASKS; i++)
+    {
+        sched_task_t *t = &sched_tasks[i];
+        if (t->fn)
+            continue;
+        t->arg = arg;
+        t->timed = false;
+        t->posted = 0;
+        t->fn = fn; // last: the slot only counts as used once complete
+        return i;
+    }
+    return SCHED_INVALID;
+}
+
+void sched_remove(sched_id_t id)
+{
+    if (id >= SCHED_MAX_TASKS)
+        return;
+
+    uint8_t sreg = SREG;
+    cli(); // fn is two bytes
+    sched_tasks[id].fn = NULL;
+    sched_tasks[id].timed = false;
+    sched_tasks[id].posted = 0;
+    SREG = sreg;
+}
+
+void sched_post(sched_id_t id)
+{
+    if (id >= SCHED_MAX_TASKS)
+        return;
+    sched_tasks[id].posted = 1;
+    sched_flag = 1;
+}
+
+static void sched_arm(sched_id_t id, uint32_t delay_ms, uint32_t period_ms)
+{
+    if (id >= SCHED_MAX_TASKS)
+        return;
+    sched_task_t *t = &sched_tasks[id];
+    t->due = time_ms() + delay_ms;
+    t->period = period_ms;
+    t->timed = true;
+}
+
+void sched_delay(sched_id_t id, uint32_t delay_ms)
+{
+    sched_arm(id, delay_ms, 0);
+}
+
+void sched_every(sched_id_t id, uint32_t period_ms)
+{
+    sched_arm(id, period_ms, period_ms);
+}
+
+void sched_cancel(sched_id_t id)
+{
+    if (id >= SCHED_MAX_TASKS)
+        return;
+    sched_tasks[id].timed = false;
+    sched_tasks[id].posted = 0;
+}
+
+bool sched_run_once(void)
+{
+    bool ran = false;
+    uint32_t now = time_ms();
+
+    sched_flag = 0; // posts from here on show up in the next idle check
+
+    for (uint8_t i = 0; i < SCHED_MAX_TASKS; i++)
+    {
+        sched_task_t *t = &sched_tasks[i];
+        if (!t->fn)
+            continue;
+
+        bool go = false;
+        if (t->posted)
+        {
+            t->posted = 0;
+            go = true;
+        }
+        if (t->timed && (int32_t)(now - t->due) >= 0)
+        {
+            if (t->period)
+            {
+                t->due += t->period;
+                if ((int32_t)(now - t->due) >= 0)
+                    t->due = now + t->period; // fell a whole period behind: resync
+            }
+            else
+            {
+                t->timed = false;
+            }
+            go = true;
+        }
+
+        if (go)
+        {
+            t->fn(t->arg);
+            ran = true;
+        }
+    }
+    return ran;
+}
+
+void sched_run(void)
+{
+    while (1)
+    {
+        if (sched_run_once())
+            continue;
+
+        set_sleep_mode(SLEEP_MODE_IDLE); // timers keep running, Timer0 wakes us every ~1 ms
+        cli();
+        if (!sched_flag)
+        {
+            sleep_enable();
+            sei();
+            sleep_cpu();
+            sleep_disable();
+        }
+        sei();
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef SCHED_H
+#define SCHED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Cooperative run-to-completion scheduler.
+// Tasks live in a fixed table (no heap) and run from sched_run() in the main
+// context, one at a time, each until it returns. A task becomes ready when:
+//   - an ISR or another task posts it (sched_post, one byte store, ISR-safe),
+//   - its one-shot delay expires (sched_delay),
+//   - its period elapses (sched_every; the next due time advances by the
+//     period, so a late run does not accumulate drift).
+// With nothing ready the CPU sleeps in SLEEP_MODE_IDLE; any interrupt wakes it,
+// and the timebase overflow (~1 ms) bounds the latency of timed tasks.
+//
+// Typical event sources:
+//   uart0_set_rx_callback(on_rx)       on_rx() { sched_post(rx_task); }
+//   i2c_xfer_t.callback                -> sched_post(...) when the transfer is done
+//   gpio_attach_interrupt(pin, e, cb)  -> sched_post(...) on the pin change
+
+#ifndef SCHED_MAX_TASKS
+#define SCHED_MAX_TASKS 8
+#endif
+
+#define SCHED_INVALID 0xFF
+
+typedef uint8_t sched_id_t;
+typedef void (*sched_fn_t)(void *arg);
+
+void       sched_init(void);
+sched_id_t sched_add(sched_fn_t fn, void *arg);      // SCHED_INVALID when the table is full
+void       sched_remove(sched_id_t id);
+
+void sched_post(sched_id_t id);                      // ISR-safe: run once, soon
+void sched_delay(sched_id_t id, uint32_t delay_ms);  // run once after delay_ms
+void sched_every(sched_id_t id, uint32_t period_ms); // first run after one period
+void sched_cancel(sched_id_t id);                    // drop pending post and timer
+
+bool sched_run_once(void);      // one pass over the table, true if a task ran
+void sched_run(void);           // forever: run ready tasks, sleep when idle
+
+#endif
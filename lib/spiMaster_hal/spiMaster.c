@@ -0,0 +1,222 @@
+// Register-level SPI master (SPCR/SPSR/SPDR).
+//   1) Configuration:
+//      - spi_device_init() folds mode/bit order/clock divider into SPCR/SPSR values once;
+//        spi_select() only rewrites the registers when another device was active.
+//      - f_osc/2, /8, /32 need SPI2X (SPSR bit 0) on top of SPR1:0.
+//
+//   2) Burst transfer:
+//      - The next TX byte is fetched from memory while the current one shifts out,
+//        and SPDR is reloaded right after SPIF, so the gap between bytes is a few cycles.
+//      - Separate loops for TX-only / full-duplex keep the RX store off the TX-only path.
+//
+//   3) ISR mode:
+//      - SPI_STC_vect stores the received byte and loads the next one; the callback
+//        runs after the last byte. Blocking calls wait for it to finish first.
+
+#include "spiMaster.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+// SPR1:0 + SPI2X for each spi_clkdiv_t
+static const uint8_t spi_div_bits[] = {
+    /* DIV2   */ 0x80 | 0,
+    /* DIV4   */ 0x00 | 0,
+    /* DIV8   */ 0x80 | 1,
+    /* DIV16  */ 0x00 | 1,
+    /* DIV32  */ 0x80 | 2,
+    /* DIV64  */ 0x00 | 2,
+    /* DIV128 */ 0x00 | 3
+};
+#define SPI_DIV_2X 0x80
+
+static const spi_device_t *spi_active;  // device whose config is in SPCR/SPSR
+
+// Async transfer state (owned by SPI_STC_vect while spi_async_busy)
+static const uint8_t *spi_async_tx;
+static uint8_t *spi_async_rx;
+static uint16_t spi_async_len;
+static uint16_t spi_async_idx;
+static spi_callback_t spi_async_cb;
+static void *spi_async_user;
+static volatile bool spi_async_busy;
+
+static inline void spi_wait_async(void)
+{
+    while (spi_async_busy)
+    {
+        ;
+    }
+}
+
+void spi_init(void)
+{
+    // MOSI, SCK, SS outputs; MISO input
+    gpio_pin_mode(SPI_PIN_SS, GPIO_OUTPUT);
+    gpio_write(SPI_PIN_SS, GPIO_HIGH);
+    gpio_pin_mode(SPI_PIN_MOSI, GPIO_OUTPUT);
+    gpio_pin_mode(SPI_PIN_SCK, GPIO_OUTPUT);
+    gpio_pin_mode(SPI_PIN_MISO, GPIO_INPUT);
+
+    PRR &= (uint8_t)~(1 << PRSPI);
+
+    // Master, mode 0, MSB first, f_osc/4
+    SPCR = (1 << SPE) | (1 << MSTR);
+    SPSR = 0;
+    (void)SPSR;
+    (void)SPDR; // clear a stale SPIF
+
+    spi_active = NULL;
+    spi_async_busy = false;
+}
+
+void spi_deinit(void)
+{
+    spi_wait_async();
+    SPCR = 0;
+    spi_active = NULL;
+}
+
+spi_status_t spi_device_init(spi_device_t *dev, gpio_pin_t cs, const spi_config_t *cfg)
+{
+    if (!dev || !cfg || cfg->mode > SPI_MODE3 || cfg->clkdiv > SPI_CLK_DIV128)
+        return SPI_ERR_PARAM;
+    if (!gpio_pin_mode(cs, GPIO_OUTPUT))
+        return SPI_ERR_PARAM;
+    gpio_write(cs, GPIO_HIGH); // deselected
+
+    uint8_t div = spi_div_bits[cfg->clkdiv];
+
+    dev->cs = cs;
+    dev->spcr = (uint8_t)((1 << SPE) | (1 << MSTR) |
+                          ((uint8_t)cfg->mode << CPHA) |          // CPOL:CPHA are adjacent
+                          (cfg->bitorder == SPI_LSB_FIRST ? (1 << DORD) : 0) |
+                          (div & 0x03));
+    dev->spsr = (div & SPI_DIV_2X) ? (1 << SPI2X) : 0;
+    return SPI_OK;
+}
+
+void spi_select(const spi_device_t *dev)
+{
+    spi_wait_async();
+    if (dev != spi_active)
+    {
+        SPCR = dev->spcr;
+        SPSR = dev->spsr;
+        spi_active = dev;
+    }
+    gpio_write(dev->cs, GPIO_LOW);
+}
+
+void spi_deselect(const spi_device_t *dev)
+{
+    spi_wait_async();
+    gpio_write(dev->cs, GPIO_HIGH);
+}
+
+// --------- Blocking ----------
+uint8_t spi_transfer(uint8_t b)
+{
+    spi_wait_async();
+    SPDR = b;
+    while (!(SPSR & (1 << SPIF)))
+    {
+        ;
+    }
+    return SPDR;
+}
+
+void spi_transfer_buf(const uint8_t *tx, uint8_t *rx, uint16_t len)
+{
+    if (len == 0)
+        return;
+    spi_wait_async();
+
+    SPDR = tx ? tx[0] : 0xFF;
+
+    if (!rx)
+    {
+        // TX only: fetch next, wait, reload
+        for (uint16_t i = 1; i < len; i++)
+        {
+            uint8_t next = tx ? tx[i] : 0xFF;
+            while (!(SPSR & (1 << SPIF)))
+            {
+                ;
+            }
+            SPDR = next; // SPSR read + SPDR access clears SPIF
+        }
+        while (!(SPSR & (1 << SPIF)))
+        {
+            ;
+        }
+        (void)SPDR;
+        return;
+    }
+
+    // Full duplex: reload SPDR first, then store what just came in
+    for (uint16_t i = 1; i < len; i++)
+    {
+        uint8_t next = tx ? tx[i] : 0xFF;
+        while (!(SPSR & (1 << SPIF)))
+        {
+            ;
+        }
+        uint8_t in = SPDR;
+        SPDR = next;
+        rx[i - 1] = in;
+    }
+    while (!(SPSR & (1 << SPIF)))
+    {
+        ;
+    }
+    rx[len - 1] = SPDR;
+}
+
+// --------- ISR mode ----------
+ISR(SPI_STC_vect)
+{
+    uint8_t in = SPDR;
+    uint16_t i = spi_async_idx;
+
+    if (spi_async_rx)
+        spi_async_rx[i] = in;
+    i++;
+
+    if (i < spi_async_len)
+    {
+        SPDR = spi_async_tx ? spi_async_tx[i] : 0xFF;
+        spi_async_idx = i;
+        return;
+    }
+
+    SPCR &= (uint8_t)~(1 << SPIE);
+    spi_async_busy = false;
+    if (spi_async_cb)
+        spi_async_cb(spi_async_user);
+}
+
+spi_status_t spi_transfer_async(const uint8_t *tx, uint8_t *rx, uint16_t len,
+                                spi_callback_t cb, void *user)
+{
+    if (len == 0)
+        return SPI_ERR_PARAM;
+    if (spi_async_busy)
+        return SPI_ERR_BUSY;
+
+    spi_async_tx = tx;
+    spi_async_rx = rx;
+    spi_async_len = len;
+    spi_async_idx = 0;
+    spi_async_cb = cb;
+    spi_async_user = user;
+    spi_async_busy = true;
+
+    SPCR |= (1 << SPIE);
+    SPDR = tx ? tx[0] : 0xFF; // first byte, the rest follow from SPI_STC_vect
+    return SPI_OK;
+}
+
+bool spi_busy(void)
+{
+    return spi_async_busy;
+}
@@ -0,0 +1,80 @@
+#ifndef SPI_MASTER_H
+#define SPI_MASTER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "gpio.h"
+
+// Hardware SPI pins (fixed on the ATmega328P)
+#define SPI_PIN_SS   PIN_D10   // forced to output: as an input, LOW would drop us to slave mode
+#define SPI_PIN_MOSI PIN_D11
+#define SPI_PIN_MISO PIN_D12
+#define SPI_PIN_SCK  PIN_D13
+
+typedef enum {
+    SPI_OK = 0,
+    SPI_ERR_PARAM,
+    SPI_ERR_BUSY    // async transfer in progress
+} spi_status_t;
+
+typedef enum {
+    SPI_MODE0 = 0,  // CPOL=0, CPHA=0
+    SPI_MODE1,      // CPOL=0, CPHA=1
+    SPI_MODE2,      // CPOL=1, CPHA=0
+    SPI_MODE3       // CPOL=1, CPHA=1
+} spi_mode_t;
+
+typedef enum {
+    SPI_MSB_FIRST = 0,
+    SPI_LSB_FIRST
+} spi_bitorder_t;
+
+typedef enum {
+    SPI_CLK_DIV2 = 0,   // 8 MHz @16 MHz (SPI2X)
+    SPI_CLK_DIV4,
+    SPI_CLK_DIV8,
+    SPI_CLK_DIV16,
+    SPI_CLK_DIV32,
+    SPI_CLK_DIV64,
+    SPI_CLK_DIV128
+} spi_clkdiv_t;
+
+typedef struct {
+    spi_mode_t mode;
+    spi_bitorder_t bitorder;
+    spi_clkdiv_t clkdiv;
+} spi_config_t;
+
+// Per-device handle: chip select + register values precomputed once
+typedef struct {
+    gpio_pin_t cs;      // active low
+    uint8_t spcr;
+    uint8_t spsr;       // SPI2X
+} spi_device_t;
+
+typedef void (*spi_callback_t)(void *user);   // runs in ISR context
+
+// ---------- Core ----------
+void         spi_init(void);     // pins + master enable (mode 0, MSB first, f_osc/4)
+void         spi_deinit(void);
+spi_status_t spi_device_init(spi_device_t *dev, gpio_pin_t cs, const spi_config_t *cfg);
+
+// Apply dev's mode/clock (only if it differs from the active one) and pull CS low
+void spi_select(const spi_device_t *dev);
+void spi_deselect(const spi_device_t *dev);
+
+// ---------- Blocking transfers (pipelined against SPIF) ----------
+uint8_t spi_transfer(uint8_t b);
+// tx == NULL sends 0xFF, rx == NULL discards what comes back
+void    spi_transfer_buf(const uint8_t *tx, uint8_t *rx, uint16_t len);
+
+// ---------- ISR-driven transfer (SPI_STC_vect) ----------
+// One byte per interrupt, so it frees the CPU only at the slower clocks;
+// at f_osc/2 the blocking burst loop is faster. Buffers must stay valid
+// until spi_busy() is false / the callback ran. CS handling stays with the caller.
+spi_status_t spi_transfer_async(const uint8_t *tx, uint8_t *rx, uint16_t len,
+                                spi_callback_t cb, void *user);
+bool         spi_busy(void);
+
+#endif
@@ -0,0 +1,109 @@
+#include "hal_stats.h"
+#include "timebase.h"
+#include <stddef.h>
+#include <string.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+_Static_assert(sizeof(hal_stats_t) <= 255, "hal_stats_t must fit the 8-bit dump length");
+
+hal_stats_t hal_stats = {
+    .version = HAL_STATS_VERSION,
+    .i2c_addrs = HAL_STATS_I2C_ADDRS,
+    .i2c_addr = { [0 ... HAL_STATS_I2C_ADDRS - 1] = { .addr7 = 0xFF } },
+};
+
+// Counters to zero, header kept, per-address slots freed (interrupts off)
+static void hal_stats_clear(void)
+{
+    memset((uint8_t *)&hal_stats + offsetof(hal_stats_t, uart_tx_bytes), 0,
+           sizeof(hal_stats) - offsetof(hal_stats_t, uart_tx_bytes));
+    for (uint8_t i = 0; i < HAL_STATS_I2C_ADDRS; i++)
+        hal_stats.i2c_addr[i].addr7 = 0xFF;
+    hal_stats.reset_ms = time_ms();
+}
+
+void hal_stats_snapshot(hal_stats_t *out, bool reset)
+{
+    uint32_t now = time_ms();
+
+    uint8_t sreg = SREG;
+    cli();
+    if (out)
+    {
+        memcpy(out, &hal_stats, sizeof(hal_stats));
+        out->t_ms = now;
+    }
+    if (reset)
+        hal_stats_clear();
+    SREG = sreg;
+}
+
+void hal_stats_reset(void)
+{
+    hal_stats_snapshot(NULL, true);
+}
+
+uart_status_t hal_stats_dump(bool reset, uint32_t timeout)
+{
+    hal_stats_t s;
+    hal_stats_snapshot(&s, reset);
+
+    const uint8_t *p = (const uint8_t *)&s;
+    uint8_t sum = 0;
+    for (uint8_t i = 0; i < sizeof(s); i++)
+        sum = (uint8_t)(sum + p[i]);
+
+    const uint8_t head[3] = { 'H', 'S', (uint8_t)sizeof(s) };
+    uart_status_t st = uart0_write(head, sizeof(head), timeout);
+    if (st == UART_OK)
+        st = uart0_write(p, sizeof(s), timeout);
+    if (st == UART_OK)
+        st = uart0_write_byte(sum, timeout);
+    return st;
+}
+
+#if HAL_STATS
+void hal_stats_i2c_result(uint8_t addr7, uint8_t status)
+{
+    uint8_t sreg = SREG;
+    cli();
+    hal_stats.i2c_xfers++;
+    switch (status)
+    {
+    case HAL_STATS_I2C_NACK: hal_stats.i2c_nack++; break;
+    case HAL_STATS_I2C_TIMEOUT:
+    case HAL_STATS_I2C_STOP_TIMEOUT: hal_stats.i2c_timeout++; break;
+    case HAL_STATS_I2C_ARB_LOST: hal_stats.i2c_arb_lost++; break;
+    case HAL_STATS_I2C_BUS_ERROR: hal_stats.i2c_bus_error++; break;
+    default: break;
+    }
+
+    // Own slot, or claim the first free one; later addresses only hit the totals
+    hal_stats_i2c_addr_t *a = NULL;
+    for (uint8_t i = 0; i < HAL_STATS_I2C_ADDRS; i++)
+    {
+        uint8_t slot = hal_stats.i2c_addr[i].addr7;
+        if (slot == addr7 || slot == 0xFF)
+        {
+            a = &hal_stats.i2c_addr[i];
+            a->addr7 = addr7;
+            break;
+        }
+    }
+    if (a)
+    {
+        a->xfers++;
+        switch (status)
+        {
+        case HAL_STATS_I2C_NACK: a->nack++; break;
+        case HAL_STATS_I2C_TIMEOUT:
+        case HAL_STATS_I2C_STOP_TIMEOUT: a->timeout++; break;
+        case HAL_STATS_I2C_ARB_LOST: a->arb_lost++; break;
+        case HAL_STATS_I2C_BUS_ERROR: a->bus_error++; break;
+        default: break;
+        }
+    }
+    SREG = sreg;
+}
+#endif
@@ -0,0 +1,100 @@
+#ifndef HAL_STATS_H
+#define HAL_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart0.h"
+
+// Driver health counters for field diagnostics.
+// Off by default: the hooks in the drivers compile to nothing. Enable with
+// -DHAL_STATS=1 in build_flags (every translation unit must agree).
+// UART0 counts bytes, dropped frames by cause, RX ring high-water and the
+// longest wait for TX ring space; the I2C master counts transactions and
+// failures by cause, bus recoveries and the longest blocking bus wait, plus
+// per-address failures for the first HAL_STATS_I2C_ADDRS addresses seen.
+// Counters wrap; telemetry should look at differences between dumps.
+
+#ifndef HAL_STATS
+#define HAL_STATS 0
+#endif
+
+#ifndef HAL_STATS_I2C_ADDRS
+#define HAL_STATS_I2C_ADDRS 4   // per-address slots, first come first served
+#endif
+
+#define HAL_STATS_VERSION 1     // bump when the layout below changes
+
+typedef struct __attribute__((packed)) {
+    uint8_t  addr7;             // 0xFF = free slot
+    uint16_t xfers;             // completed transactions, any result
+    uint16_t nack;
+    uint16_t timeout;
+    uint16_t arb_lost;
+    uint16_t bus_error;
+} hal_stats_i2c_addr_t;
+
+// Binary layout of the dump (little endian, no padding)
+typedef struct __attribute__((packed)) {
+    uint8_t  version;           // HAL_STATS_VERSION
+    uint8_t  i2c_addrs;         // HAL_STATS_I2C_ADDRS
+    uint32_t t_ms;              // time_ms() of the snapshot
+    uint32_t reset_ms;          // time_ms() of the last reset
+
+    // UART0
+    uint32_t uart_tx_bytes;     // handed to UDR0
+    uint32_t uart_rx_bytes;     // received without error (ring or framing layer)
+    uint16_t uart_fe;           // frame errors (FE0)
+    uint16_t uart_dor;          // hardware overruns (DOR0): RX ISR too late
+    uint16_t uart_upe;          // parity errors (UPE0)
+    uint16_t uart_rx_full;      // good bytes dropped because the RX ring was full
+    uint8_t  uart_rx_hwm;       // highest RX ring fill level
+    uint32_t uart_tx_wait_max_us; // longest blocking wait for TX ring space
+
+    // I2C master
+    uint16_t i2c_xfers;
+    uint16_t i2c_nack;
+    uint16_t i2c_timeout;
+    uint16_t i2c_arb_lost;
+    uint16_t i2c_bus_error;
+    uint16_t i2c_recoveries;    // SCL pulse-outs (twi_recover_lines)
+    uint32_t i2c_wait_max_us;   // longest blocking wait on the bus (one i2c_wait or TWINT)
+    hal_stats_i2c_addr_t i2c_addr[HAL_STATS_I2C_ADDRS];
+} hal_stats_t;
+
+// Copy all counters atomically; reset = start a new measurement window.
+void hal_stats_snapshot(hal_stats_t *out, bool reset);
+void hal_stats_reset(void);
+
+// Snapshot (and optional reset), then send one binary record over UART0:
+//   'H' 'S' <len> <hal_stats_t, len bytes> <sum>
+// sum = 8-bit sum of the len payload bytes. Blocks like uart0_write().
+uart_status_t hal_stats_dump(bool reset, uint32_t timeout);
+
+// ---------- Driver hooks ----------
+// Each INC/MAX/WAIT field has a single writing context (an ISR, or main), so
+// those hooks need no cli(); HAL_STATS_I2C is called from both and locks itself.
+// Readers copy the whole struct under cli().
+extern hal_stats_t hal_stats;
+
+// Results HAL_STATS_I2C() counts: the i2c_status_t values, restated here so this
+// library does not pull in the I2C master (i2cMaster.c asserts they still match)
+#define HAL_STATS_I2C_NACK         1
+#define HAL_STATS_I2C_TIMEOUT      3
+#define HAL_STATS_I2C_ARB_LOST     5
+#define HAL_STATS_I2C_BUS_ERROR    6
+#define HAL_STATS_I2C_STOP_TIMEOUT 7    // counted as a timeout
+
+#if HAL_STATS
+void hal_stats_i2c_result(uint8_t addr7, uint8_t status);
+#define HAL_STATS_INC(field)           (hal_stats.field++)
+#define HAL_STATS_MAX(field, v)        do { if ((v) > hal_stats.field) hal_stats.field = (v); } while (0)
+#define HAL_STATS_WAIT(field, start)   do { uint32_t w_ = time_us() - (start); HAL_STATS_MAX(field, w_); } while (0)
+#define HAL_STATS_I2C(addr7, st)       hal_stats_i2c_result((addr7), (uint8_t)(st))
+#else
+#define HAL_STATS_INC(field)           ((void)0)
+#define HAL_STATS_MAX(field, v)        ((void)0)
+#define HAL_STATS_I2C(addr7, st)       ((void)0)
+#define HAL_STATS_WAIT(field, start)   ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,122 @@
+// Timer0 overflow counter extended to microseconds and milliseconds.
+//   - time_us() = (overflows * 256 + TCNT0) * TIMEBASE_US_PER_TICK.
+//   - time_ms() keeps its own counter: 1024 us per overflow is 1 ms plus a
+//     24 us remainder, accumulated in 8 us units (the Arduino millis() trick).
+//   - Readers account a pending overflow themselves (and clear TOV0), so time
+//     keeps moving inside ISRs or with interrupts disabled, as long as it is
+//     read at least once per overflow period.
+//   - Tick hooks run from the same place as the overflow accounting, so each
+//     one is called exactly once per overflow whichever path took it.
+
+#include "timebase.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#if ((TIMEBASE_PRESCALER % (F_CPU / 1000000UL)) != 0) || (F_CPU % 1000000UL)
+#error "timebase: F_CPU must be 1, 2, 4, 8 or 16 MHz"
+#endif
+
+#define TIMEBASE_MS_INC   (TIMEBASE_US_PER_OVF / 1000UL)
+#define TIMEBASE_FRAC_INC ((uint8_t)((TIMEBASE_US_PER_OVF % 1000UL) >> 3))
+#define TIMEBASE_FRAC_MAX ((uint8_t)(1000UL >> 3))
+
+static volatile uint32_t tb_overflows;
+static volatile uint32_t tb_millis;
+static volatile uint8_t tb_frac;
+static timebase_hook_t tb_hooks[TIMEBASE_MAX_HOOKS];
+static uint8_t tb_hook_count;
+
+// One overflow period passed (interrupts off)
+static inline void timebase_tick(void)
+{
+    uint32_t m = tb_millis + TIMEBASE_MS_INC;
+    uint8_t f = tb_frac + TIMEBASE_FRAC_INC;
+    if (f >= TIMEBASE_FRAC_MAX)
+    {
+        f -= TIMEBASE_FRAC_MAX;
+        m++;
+    }
+    tb_millis = m;
+    tb_frac = f;
+    tb_overflows++;
+
+    for (uint8_t i = 0; i < tb_hook_count; i++)
+        tb_hooks[i]();
+}
+
+// Take over a pending TIMER0_OVF interrupt (interrupts off)
+static inline void timebase_catch_up(void)
+{
+    if (TIFR0 & (1 << TOV0))
+    {
+        TIFR0 = (1 << TOV0); // write 1 to clear
+        timebase_tick();
+    }
+}
+
+ISR(TIMER0_OVF_vect)
+{
+    timebase_tick();
+}
+
+void timebase_init(void)
+{
+    if (TIMSK0 & (1 << TOIE0))
+        return; // already running
+
+    // Fast PWM, TOP = 0xFF (keep COM0x bits of a PWM user), clk/64
+    TCCR0A = (uint8_t)((TCCR0A & 0xF0) | (1 << WGM01) | (1 << WGM00));
+    TCCR0B = (1 << CS01) | (1 << CS00);
+    TIFR0 = (1 << TOV0);
+    TIMSK0 |= (1 << TOIE0);
+}
+
+uint32_t time_us(void)
+{
+    uint8_t sreg = SREG;
+    cli();
+
+    timebase_catch_up();
+    uint32_t ovf = tb_overflows;
+    uint8_t t = TCNT0;
+    // Overflowed right after the catch-up: TCNT0 already wrapped
+    if ((TIFR0 & (1 << TOV0)) && t < 255)
+        ovf++;
+
+    SREG = sreg;
+    return ((ovf << 8) + t) * TIMEBASE_US_PER_TICK;
+}
+
+uint32_t time_ms(void)
+{
+    uint8_t sreg = SREG;
+    cli();
+
+    timebase_catch_up();
+    uint32_t m = tb_millis;
+
+    SREG = sreg;
+    return m;
+}
+
+bool timebase_add_hook(timebase_hook_t hook)
+{
+    if (!hook)
+        return false;
+
+    uint8_t sreg = SREG;
+    cli();
+    for (uint8_t i = 0; i < tb_hook_count; i++)
+    {
+        if (tb_hooks[i] == hook)
+        {
+            SREG = sreg;
+            return true; // already registered (repeated init)
+        }
+    }
+    bool ok = tb_hook_count < TIMEBASE_MAX_HOOKS;
+    if (ok)
+        tb_hooks[tb_hook_count++] = hook;
+    SREG = sreg;
+    return ok;
+}
@@ -0,0 +1,87 @@
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+// Monotonic timebase on Timer0 (shared clock for timeouts and timestamps).
+// Timer0 runs free in fast PWM mode (TOP = 0xFF) at clk/64, so OC0A/OC0B
+// (D6/D5) stay usable for PWM at this frequency:
+//   one tick = 4 us, one overflow = 1024 us @16 MHz.
+// TIMER0_OVF_vect belongs to this module (do not link Arduino's wiring.c).
+#define TIMEBASE_PRESCALER   64UL
+#define TIMEBASE_US_PER_TICK (TIMEBASE_PRESCALER / (F_CPU / 1000000UL))
+#define TIMEBASE_US_PER_OVF  (TIMEBASE_US_PER_TICK * 256UL)
+
+// Timeout value that never expires
+#define TIME_FOREVER 0xFFFFFFFFUL
+
+// Periodic hooks called once per Timer0 overflow (TIMEBASE_US_PER_OVF), with
+// interrupts disabled: from TIMER0_OVF_vect, or from a time_us()/time_ms()
+// caller that took over a pending overflow. Keep them to a few cycles.
+#ifndef TIMEBASE_MAX_HOOKS
+#define TIMEBASE_MAX_HOOKS 2
+#endif
+
+typedef void (*timebase_hook_t)(void);
+
+void     timebase_init(void);   // idempotent, drivers call it from their init
+uint32_t time_us(void);         // wraps after ~71.6 min
+uint32_t time_ms(void);         // wraps after ~49.7 days
+
+bool timebase_add_hook(timebase_hook_t hook);  // false when all slots are taken
+
+// Deadline helpers (wrap-safe for spans up to 2^31)
+static inline uint32_t time_deadline_us(uint32_t timeout_us)
+{
+    return time_us() + timeout_us;
+}
+
+static inline bool time_reached_us(uint32_t deadline)
+{
+    return (int32_t)(time_us() - deadline) >= 0;
+}
+
+static inline uint32_t time_deadline_ms(uint32_t timeout_ms)
+{
+    return time_ms() + timeout_ms;
+}
+
+static inline bool time_reached_ms(uint32_t deadline)
+{
+    return (int32_t)(time_ms() - deadline) >= 0;
+}
+
+// Poll-loop helper: true once timeout_us has passed since start (TIME_FOREVER never does)
+static inline bool time_elapsed_us(uint32_t start, uint32_t timeout_us)
+{
+    return timeout_us != TIME_FOREVER && (time_us() - start) >= timeout_us;
+}
+
+// Wait-loop helper: sleep in SLEEP_MODE_IDLE until the next interrupt if cond
+// still holds. cond is checked with interrupts off and SEI only takes effect
+// after SLEEP, so a wake-up ISR landing in between is never missed. Call with
+// interrupts enabled only; the Timer0 overflow ends every sleep within
+// TIMEBASE_US_PER_OVF, so timeouts around it keep working.
+#define TIME_SLEEP_WHILE(cond)            \
+    do                                    \
+    {                                     \
+        set_sleep_mode(SLEEP_MODE_IDLE);  \
+        cli();                            \
+        if (cond)                         \
+        {                                 \
+            sleep_enable();               \
+            sei();                        \
+            sleep_cpu();                  \
+            sleep_disable();              \
+        }                                 \
+        sei();                            \
+    } while (0)
+
+#endif
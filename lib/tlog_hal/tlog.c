@@ -0,0 +1,155 @@
+// Binary event log internals:
+//   1) Ring:
+//      - Byte ring of variable-length records [len][seq][id][t_us LE 4][args len],
+//        free-running 8-bit indices. Producers are main and any ISR, so tlog_put()
+//        reserves and fills its record under cli() (7 + TLOG_MAX_ARGS bytes at most).
+//      - tlog_poll() is the only consumer (main context): it copies the record out,
+//        then advances the tail; a producer never touches bytes behind the tail.
+//      - The ring is not volatile: _MemoryBarrier() keeps the record stores before the
+//        head store, and the record loads after the head check (as in adc_read()).
+//
+//   2) Sequence numbers:
+//      - seq is taken for every call, before the space check: a record dropped here
+//        leaves the same gap on the host as a frame lost on the wire.
+//
+//   3) Frame:
+//      - payload = seq, id, t_us, args, CRC-16/XMODEM big endian (the same CRC as the
+//        uart0_frame RX decoder: the residue over payload + CRC is 0).
+//      - COBS encoded, 0x00 delimiter. The payload is < 254 bytes, so the overhead is
+//        exactly one code byte plus the delimiter.
+//      - tlog_poll() only starts a frame when the whole frame fits in the UART0 TX ring,
+//        so uart0_write_nb() never truncates it and main never waits for the wire.
+
+#include "tlog.h"
+#include "timebase.h"
+#include <util/crc16.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/cpufunc.h>
+
+#if (TLOG_RING_SIZE < 16) || (TLOG_RING_SIZE > 128) || (TLOG_RING_SIZE & (TLOG_RING_SIZE - 1))
+#error "TLOG_RING_SIZE must be a power of two in 16..128"
+#endif
+
+#define TLOG_HDR       7                            // len, seq, id, t_us
+#define TLOG_PAYLOAD   (TLOG_HDR - 1 + TLOG_MAX_ARGS + 2) // seq .. CRC
+#define TLOG_FRAME_MAX (TLOG_PAYLOAD + 2)           // + COBS code byte + delimiter
+#define TLOG_RING_MASK (TLOG_RING_SIZE - 1)
+
+#if (TLOG_MAX_ARGS < 1) || (TLOG_HDR + TLOG_MAX_ARGS > TLOG_RING_SIZE)
+#error "TLOG_MAX_ARGS must be at least 1 and a record must fit TLOG_RING_SIZE"
+#endif
+#if TLOG_FRAME_MAX > UART0_TX_BUFFER_SIZE
+#error "a tlog frame must fit UART0_TX_BUFFER_SIZE"
+#endif
+
+static uint8_t tlog_ring[TLOG_RING_SIZE];
+static volatile uint8_t tlog_head;      // written by producers (under cli)
+static volatile uint8_t tlog_tail;      // written by tlog_poll()
+static uint8_t tlog_seq;                // producers only (under cli)
+static volatile uint16_t tlog_drops;
+
+void tlog_init(void)
+{
+    timebase_init(); // record timestamps
+
+    uint8_t sreg = SREG;
+    cli();
+    tlog_head = tlog_tail = 0;
+    tlog_seq = 0;
+    tlog_drops = 0;
+    SREG = sreg;
+}
+
+bool tlog_put(uint8_t id, const void *args, uint8_t len)
+{
+    uint32_t t = time_us();
+    const uint8_t *a = (const uint8_t *)args;
+    bool ok = false;
+
+    uint8_t sreg = SREG;
+    cli();
+    uint8_t seq = tlog_seq++;
+    uint8_t head = tlog_head;
+    if (len <= TLOG_MAX_ARGS &&
+        (uint8_t)(TLOG_RING_SIZE - (uint8_t)(head - tlog_tail)) >= (uint8_t)(TLOG_HDR + len))
+    {
+        tlog_ring[head++ & TLOG_RING_MASK] = len;
+        tlog_ring[head++ & TLOG_RING_MASK] = seq;
+        tlog_ring[head++ & TLOG_RING_MASK] = id;
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            tlog_ring[head++ & TLOG_RING_MASK] = (uint8_t)t;
+            t >>= 8;
+        }
+        for (uint8_t i = 0; i < len; i++)
+            tlog_ring[head++ & TLOG_RING_MASK] = a[i];
+        _MemoryBarrier(); // record before the index that publishes it
+        tlog_head = head;
+        ok = true;
+    }
+    else
+    {
+        tlog_drops++;
+    }
+    SREG = sreg;
+    return ok;
+}
+
+bool tlog_poll(void)
+{
+    uint8_t tail = tlog_tail;
+    if (tlog_head == tail)
+        return false;
+    _MemoryBarrier(); // no record byte loaded before head said it is there
+
+    uint8_t len = tlog_ring[tail & TLOG_RING_MASK];
+    uint8_t n = (uint8_t)(TLOG_HDR - 1 + len); // seq .. args
+    if (uart0_tx_free() < (uint8_t)(n + 4))    // + CRC, code byte, delimiter
+        return false;
+
+    // frame[0] is the COBS code of the first block, the payload starts at frame[1]
+    uint8_t frame[TLOG_FRAME_MAX];
+    uint16_t crc = 0;
+    tail++;
+    for (uint8_t i = 1; i <= n; i++)
+    {
+        uint8_t b = tlog_ring[tail++ & TLOG_RING_MASK];
+        frame[i] = b;
+        crc = _crc_xmodem_update(crc, b);
+    }
+    tlog_tail = tail; // record copied: the slots are free
+
+    frame[n + 1] = (uint8_t)(crc >> 8);
+    frame[n + 2] = (uint8_t)crc;
+
+    // COBS in place: each zero becomes the distance to the next zero (or the end)
+    uint8_t code_at = 0;
+    for (uint8_t i = 1; i <= (uint8_t)(n + 2); i++)
+    {
+        if (frame[i] == 0)
+        {
+            frame[code_at] = (uint8_t)(i - code_at);
+            code_at = i;
+        }
+    }
+    frame[code_at] = (uint8_t)(n + 3 - code_at);
+    frame[n + 3] = 0x00;
+
+    uart0_write_nb(frame, (size_t)n + 4);
+    return true;
+}
+
+uint8_t tlog_pending(void)
+{
+    return (uint8_t)(tlog_head - tlog_tail);
+}
+
+uint16_t tlog_dropped(void)
+{
+    uint8_t sreg = SREG;
+    cli();
+    uint16_t d = tlog_drops;
+    SREG = sreg;
+    return d;
+}
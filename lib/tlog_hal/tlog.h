@@ -0,0 +1,65 @@
+#ifndef TLOG_H
+#define TLOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart0.h"
+
+// Binary event log over UART0.
+// A log call stores [seq, id, time_us(), raw argument bytes] in a RAM ring
+// (a few dozen cycles, any context, no formatting); tlog_poll() later moves
+// whole records into the UART0 TX ring as COBS frames, so the CPU never waits
+// for the wire. Ids and their format strings live in one X-macro table
+// (src/tlog/tlog_ids.h for the demo) that the host decoder (tools/tlog) compiles too.
+//
+// Frame on the wire (COBS encoded, 0x00 terminated):
+//   seq (1) | id (1) | t_us (4, LE) | args (0..TLOG_MAX_ARGS) | CRC-16/XMODEM (2, BE)
+// seq counts every log call, including records dropped because the ring was
+// full: a gap in seq on the host means lost records, wherever they were lost.
+
+#ifndef TLOG_RING_SIZE
+#define TLOG_RING_SIZE 128      // bytes, power of two in 16..128
+#endif
+
+#ifndef TLOG_MAX_ARGS
+#define TLOG_MAX_ARGS 8         // argument bytes per record
+#endif
+
+void    tlog_init(void);
+bool    tlog_put(uint8_t id, const void *args, uint8_t len); // false: dropped (ring full / too long)
+bool    tlog_poll(void);        // main loop: send one record if UART0 has room, true if sent
+uint8_t tlog_pending(void);     // bytes waiting in the ring
+uint16_t tlog_dropped(void);    // records dropped since init (wraps)
+
+// Typed call sites: the arguments are packed with their own sizes
+// (cast them to the types of the id's signature).
+#define TLOG0(id) tlog_put((id), 0, 0)
+#define TLOG1(id, a)                                                        \
+    do {                                                                    \
+        __typeof__(a) tlog_a_ = (a);                                        \
+        tlog_put((id), &tlog_a_, sizeof(tlog_a_));                          \
+    } while (0)
+#define TLOG2(id, a, b)                                                     \
+    do {                                                                    \
+        struct __attribute__((packed)) {                                    \
+            __typeof__(a) a_; __typeof__(b) b_;                             \
+        } tlog_p_ = { (a), (b) };                                           \
+        tlog_put((id), &tlog_p_, sizeof(tlog_p_));                          \
+    } while (0)
+#define TLOG3(id, a, b, c)                                                  \
+    do {                                                                    \
+        struct __attribute__((packed)) {                                    \
+            __typeof__(a) a_; __typeof__(b) b_; __typeof__(c) c_;           \
+        } tlog_p_ = { (a), (b), (c) };                                      \
+        tlog_put((id), &tlog_p_, sizeof(tlog_p_));                          \
+    } while (0)
+#define TLOG4(id, a, b, c, d)                                               \
+    do {                                                                    \
+        struct __attribute__((packed)) {                                    \
+            __typeof__(a) a_; __typeof__(b) b_; __typeof__(c) c_;           \
+            __typeof__(d) d_;                                               \
+        } tlog_p_ = { (a), (b), (c), (d) };                                 \
+        tlog_put((id), &tlog_p_, sizeof(tlog_p_));                          \
+    } while (0)
+
+#endif
@@ -1,63 +1,346 @@
 #include "uart0.h"
+#include "uart0_frame.h"
+#include "hal_stats.h"
 #include <avr/io.h>
+#include <avr/interrupt.h>
+#if UART0_RS485
+#include "gpio_fast.h"
+#endif
+
+#if (UART0_RX_BUFFER_SIZE < 2) || (UART0_RX_BUFFER_SIZE > 128) || (UART0_RX_BUFFER_SIZE & (UART0_RX_BUFFER_SIZE - 1))
+#error "UART0_RX_BUFFER_SIZE must be a power of two in 2..128"
+#endif
+#if (UART0_TX_BUFFER_SIZE < 2) || (UART0_TX_BUFFER_SIZE > 128) || (UART0_TX_BUFFER_SIZE & (UART0_TX_BUFFER_SIZE - 1))
+#error "UART0_TX_BUFFER_SIZE must be a power of two in 2..128"
+#endif
+
+#define UART0_RX_MASK (UART0_RX_BUFFER_SIZE - 1)
+#define UART0_TX_MASK (UART0_TX_BUFFER_SIZE - 1)
+
+// USART_TX_vect (TXC0) is used by the sleeping flush and by the RS-485 turnaround
+#define UART0_TX_ISR (UART0_SLEEP_WAIT || UART0_RS485)
+
+// Ring element: one frame; bit 8 carries RXB80/TXB80 in 9-bit builds
+#if UART0_9BIT
+typedef uint16_t uart0_word_t;
+#else
+typedef uint8_t uart0_word_t;
+#endif
+
+// ----------------- Ring buffers -----------------
+// Single-producer / single-consumer rings with free-running 8-bit indices:
+//   RX: producer = USART_RX_vect,  consumer = main loop
+//   TX: producer = main loop,      consumer = USART_UDRE_vect
+// Every index has exactly one writer and 8-bit loads/stores are atomic on AVR,
+// so no side needs cli(). (head - tail) mod 256 is the fill level.
+// The buffers are volatile so the data store is never reordered after the
+// index store that publishes it.
+static volatile uart0_word_t rx_buf[UART0_RX_BUFFER_SIZE];
+static volatile uint8_t rx_head;      // written by ISR
+static volatile uint8_t rx_tail;      // written by main
+static volatile uint8_t rx_err_count; // written by ISR: dropped frames
+static uint8_t rx_err_seen;           // main-side copy of rx_err_count
 
-#ifndef UART0_TIMEOUT_MAX
-#define UART0_TIMEOUT_MAX 0xFFFFFFFFUL
+static volatile uart0_word_t tx_buf[UART0_TX_BUFFER_SIZE];
+static volatile uint8_t tx_head;      // written by main
+static volatile uint8_t tx_tail;      // written by ISR
+static volatile bool tx_started;      // written by ISR: UDR0 loaded since init
+#if UART0_TX_ISR
+static volatile bool tx_done;         // written by ISR: USART_TX_vect consumed TXC0
+#endif
+
+static uart0_rx_cb_t rx_cb;
+static bool tx_spin;                  // frame <= UART0_TX_SPIN_CYCLES: write UDR0 directly
+
+#if UART0_9BIT
+// Multiprocessor mode: set under cli(), read by USART_RX_vect
+static bool mpcm_on;
+static uint8_t mpcm_addr;
+static uint8_t mpcm_bcast;
+#endif
+
+#if UART0_RS485
+// Driver enable: always written to an absolute level (interrupts off), never
+// toggled, so the driver's idea of the pin cannot invert. Other writers of the
+// port must be atomic too (see uart0.h): a racing RMW after the last DE-off
+// would leave the transceiver on with no TXC0 to come
+static volatile uint8_t *de_port;
+static uint8_t de_mask;               // 0 = RS-485 control off
+static uint8_t de_active;             // de_mask (active high) or 0 (active low)
+
+static inline void uart0_de_set(bool on)
+{
+    uint8_t p = (uint8_t)(*de_port & ~de_mask);
+    *de_port = on ? (uint8_t)(p | de_active) : (uint8_t)(p | (de_active ^ de_mask));
+}
 #endif
 
 // ----------------- Small helpers -----------------
-static inline bool uart0_tx_ready(void)
+// UCSR0B is also changed by the ISRs (UDRIE0, TXCIE0, TXB80): main-side RMW under cli()
+static inline void uart0_ucsr0b_set(uint8_t bits)
 {
-    return (UCSR0A & (1 << UDRE0)) != 0;
+    uint8_t sreg = SREG;
+    cli();
+    UCSR0B |= bits;
+    SREG = sreg;
 }
 
-static inline bool uart0_rx_ready(void)
+// UCSR0A with MPCM0 changed; TXC0 is written 0 (writing back a set TXC0 would clear it)
+static inline void uart0_mpcm_write(bool on)
 {
-    return (UCSR0A & (1 << RXC0)) != 0;
+    UCSR0A = (uint8_t)((UCSR0A & (1 << U2X0)) | (on ? (1 << MPCM0) : 0));
 }
 
-static inline uart_status_t uart0_wait_flag(volatile uint8_t *reg, uint8_t mask, bool set, uint32_t timeout)
+static inline uint8_t rx_count(void)
 {
-    while (timeout--)
+    return (uint8_t)(rx_head - rx_tail);
+}
+
+static inline uint8_t tx_count(void)
+{
+    return (uint8_t)(tx_head - tx_tail);
+}
+
+// RX: move one frame from UDR0 into the ring (ISR context)
+static inline void uart0_rx_service(void)
+{
+    // Error flags and RXB80 belong to the frame in UDR0, read them first
+    uint8_t status = UCSR0A;
+#if UART0_9BIT
+    uint8_t b8 = UCSR0B & (1 << RXB80);
+#endif
+    uint8_t b = UDR0; // clears RXC0
+
+#if UART0_9BIT
+    // MPCM: the hardware only lets address frames (bit 8 set) through while we
+    // are not addressed. Ours (or broadcast) opens the gate for the data frames,
+    // anyone else's closes it again.
+    if (b8 && mpcm_on)
     {
-        if (set)
-        {
-            if (*reg & mask)
-                return UART_OK; // bit set
-        }
-        else
-        {
-            if (!(*reg & mask))
-                return UART_OK; // bit clear
-        }
+        bool ours = (b == mpcm_addr) || (b == mpcm_bcast);
+        uart0_mpcm_write(!ours);
+        if (!ours)
+            return;
     }
+#endif
+
+#if HAL_STATS
+    if (status & (1 << FE0))
+        HAL_STATS_INC(uart_fe);
+    if (status & (1 << DOR0))
+        HAL_STATS_INC(uart_dor);
+    if (status & (1 << UPE0))
+        HAL_STATS_INC(uart_upe);
+#endif
 
-    return UART_ERR_TIMEOUT;
+#if UART0_FRAMING != UART0_FRAMING_NONE
+    // Framing layer owns the RX stream
+    if (status & ((1 << FE0) | (1 << DOR0) | (1 << UPE0)))
+        uart0_frame_rx_error();
+    else
+    {
+        HAL_STATS_INC(uart_rx_bytes);
+        uart0_frame_rx(b);
+    }
+#else
+    uint8_t head = rx_head;
+    uint8_t fill = (uint8_t)(head - rx_tail);
+
+    if ((status & ((1 << FE0) | (1 << DOR0) | (1 << UPE0))) || fill >= UART0_RX_BUFFER_SIZE)
+    {
+#if HAL_STATS
+        if (!(status & ((1 << FE0) | (1 << DOR0) | (1 << UPE0))))
+            HAL_STATS_INC(uart_rx_full);
+#endif
+        rx_err_count++;
+        return;
+    }
+#if UART0_9BIT
+    rx_buf[head & UART0_RX_MASK] = b8 ? (uint16_t)(0x100 | b) : b;
+#else
+    rx_buf[head & UART0_RX_MASK] = b;
+#endif
+    rx_head = head + 1;
+    HAL_STATS_INC(uart_rx_bytes);
+    HAL_STATS_MAX(uart_rx_hwm, (uint8_t)(fill + 1));
+    if (rx_cb)
+        rx_cb();
+#endif
 }
 
-static inline uint16_t uart0_calc_ubrr(uint32_t baud, bool u2x)
+// Load one frame into an empty UDR0 (interrupts off: ISR, poll, or under cli())
+static inline void uart0_tx_load(uart0_word_t w)
 {
-    if (baud == 0)
-        return 0;
+#if UART0_RS485
+    if (de_mask)
+    {
+        uart0_de_set(true);           // driver on before the start bit
+        UCSR0B |= (1 << TXCIE0);      // turn it off again once TXC0 says the line is idle
+    }
+#endif
+#if UART0_9BIT
+    // TXB80 must be in place before UDR0 is written
+    if (w & 0x100)
+        UCSR0B |= (1 << TXB80);
+    else
+        UCSR0B &= (uint8_t)~(1 << TXB80);
+#endif
+    // Clear TXC0 (write 1) so uart0_flush() sees only this transmission
+    UCSR0A = (uint8_t)((UCSR0A & ((1 << U2X0) | (1 << MPCM0))) | (1 << TXC0));
+    UDR0 = (uint8_t)w;
+    tx_started = true;
+    HAL_STATS_INC(uart_tx_bytes);
+#if UART0_TX_ISR
+    tx_done = false;
+#endif
+}
+
+#if UART0_TX_ISR
+// TXC0: the last frame left the shift register (interrupts off)
+static inline void uart0_tx_complete(void)
+{
+    if (tx_count() != 0)
+        return; // more queued (UDRIE0 about to be set): keep the driver on
+    UCSR0B &= ~(1 << TXCIE0);
+#if UART0_RS485
+    if (de_mask)
+        uart0_de_set(false);          // driver off: the bus is the other nodes' again
+#endif
+    tx_done = true;
+}
+#endif
+
+// TX: feed the next byte to UDR0, or stop UDRE interrupts when empty (ISR context)
+static inline void uart0_tx_service(void)
+{
+    uint8_t tail = tx_tail;
+    if (tail == tx_head)
+    {
+        UCSR0B &= ~(1 << UDRIE0);
+        return;
+    }
+    uart0_tx_load(tx_buf[tail & UART0_TX_MASK]);
+    tx_tail = tail + 1;
+}
 
-    uint32_t div = u2x ? 8UL : 16UL;
-    uint32_t ubrr = (F_CPU / (div * baud)) - 1UL;
+ISR(USART_RX_vect)
+{
+    // At 1-2 Mbaud the next frame may already sit in the 2-byte RX FIFO:
+    // drain it in the same entry instead of paying the ISR prologue twice
+    do
+    {
+        uart0_rx_service();
+    } while (UCSR0A & (1 << RXC0));
+}
 
-    if (ubrr > 0x0FFFUL)
-        ubrr = 0x0FFFUL; // 12-bit UBRR limit
-    return (uint16_t)ubrr;
+ISR(USART_UDRE_vect)
+{
+    uart0_tx_service();
+}
+
+#if UART0_TX_ISR
+// Enabled by uart0_flush() as a wake-up source (UART0_SLEEP_WAIT) and while
+// the RS-485 driver is on; tx_done replaces the TXC0 bit this interrupt clears.
+ISR(USART_TX_vect)
+{
+    uart0_tx_complete();
+}
+#endif
+
+// With global interrupts disabled the ISRs cannot run (e.g. logging from inside
+// another ISR); service the hardware here so blocking calls still make progress.
+static void uart0_poll_masked(void)
+{
+    if (SREG & (1 << SREG_I))
+        return;
+
+    uint8_t a = UCSR0A;
+    if (a & (1 << RXC0))
+        uart0_rx_service();
+    if ((a & (1 << UDRE0)) && (UCSR0B & (1 << UDRIE0)))
+        uart0_tx_service();
+#if UART0_TX_ISR
+    if ((a & (1 << TXC0)) && (UCSR0B & (1 << TXCIE0)))
+    {
+        UCSR0A = (uint8_t)((a & ((1 << U2X0) | (1 << MPCM0))) | (1 << TXC0)); // as taking the ISR would
+        uart0_tx_complete();
+    }
+#endif
+}
+
+// Wait conditions of the blocking calls
+static bool uart0_tx_full(void)
+{
+    return tx_count() >= UART0_TX_BUFFER_SIZE;
+}
+
+static bool uart0_rx_empty(void)
+{
+    return rx_count() == 0;
+}
+
+static bool uart0_tx_busy(void)
+{
+    if (tx_count() != 0)
+        return true;
+    if (!tx_started || (UCSR0A & (1 << TXC0)))
+        return false;
+#if UART0_TX_ISR
+    return !tx_done;
+#else
+    return true;
+#endif
+}
+
+// One iteration of a blocking wait: poll when the ISRs cannot run, otherwise
+// (UART0_SLEEP_WAIT) sleep until an interrupt while the wait still holds.
+static void uart0_wait(bool (*busy)(void))
+{
+    if (!(SREG & (1 << SREG_I)))
+    {
+        uart0_poll_masked();
+        return;
+    }
+#if UART0_SLEEP_WAIT
+    TIME_SLEEP_WHILE(busy());
+#else
+    (void)busy;
+#endif
+}
+
+uint16_t uart0_calc_ubrr(uint32_t baud, bool u2x)
+{
+    if (baud == 0)
+        return 0;
+    return uart0_baud_calc(baud, u2x).ubrr;
 }
 
 // ----------------- Public API -----------------
-uart_status_t uart0_init(const uart0_config_t *cfg)
+uart_status_t uart0_init_baud(const uart0_config_t *cfg, uart0_baud_t baud)
 {
-    if (!cfg || cfg->baud == 0)
+    if (!cfg || baud.ubrr > 0x0FFF)
         return UART_ERR_PARAM;
 
-    // clear RXEN0, TXEN0 before configuring
-    UCSR0B &= ~((1 << TXEN0) | (1 << RXEN0));
+    timebase_init(); // timeouts run on the shared timebase
+
+    // USART0 clock on (uart0_deinit() gates it); registers ignore writes while gated
+    PRR &= (uint8_t)~(1 << PRUSART0);
+
+    // clear RXEN0, TXEN0 and the interrupt enables before configuring
+    UCSR0B &= ~((1 << TXEN0) | (1 << RXEN0) | (1 << RXCIE0) | (1 << UDRIE0) | (1 << TXCIE0));
+
+    // Both ISRs are now quiet: reset the rings
+    rx_head = rx_tail = 0;
+    tx_head = tx_tail = 0;
+    tx_started = false;
+    rx_err_count = rx_err_seen = 0;
+#if UART0_9BIT
+    mpcm_on = false;
+    UCSR0A &= (uint8_t)~((1 << MPCM0) | (1 << TXC0)); // TXC0 written 0: unchanged
+#endif
+
     // Set speed mode U2X0
-    if (cfg->use_u2x)
+    if (baud.u2x)
     {
         UCSR0A |= (1 << U2X0);
     }
@@ -66,9 +349,17 @@ uart_status_t uart0_init(const uart0_config_t *cfg)
         UCSR0A &= ~(1 << U2X0);
     }
     // 3) Set baud (UBRR0H/UBRR0L)
-    uint16_t ubrr = uart0_calc_ubrr(cfg->baud, cfg->use_u2x);
-    UBRR0H = (uint8_t)((ubrr >> 8) & 0x0F);
-    UBRR0L = (uint8_t)(ubrr & 0xFF);
+    UBRR0H = (uint8_t)((baud.ubrr >> 8) & 0x0F);
+    UBRR0L = (uint8_t)(baud.ubrr & 0xFF);
+
+    // 10-bit frame in CPU cycles (8N1; longer frames only make spinning cheaper)
+    tx_spin = (uint32_t)(baud.u2x ? 8U : 16U) * (baud.ubrr + 1U) * 10UL <= UART0_TX_SPIN_CYCLES;
+
+    // Asynchronous mode (uart0_spi may have left MSPIM selected), UCPOL0 unused.
+    // MSPIM drove XCK0 (D4) as the clock output: hand the pin back as an input.
+    if ((UCSR0C & ((1 << UMSEL01) | (1 << UMSEL00))) == ((1 << UMSEL01) | (1 << UMSEL00)))
+        DDRD &= (uint8_t)~(1 << PD4);
+    UCSR0C &= (uint8_t)~((1 << UMSEL01) | (1 << UMSEL00) | (1 << UCPOL0));
 
     // Frame format: databits/parity/stopbits => UCSR0C (and UCSZ02 in UCSR0B)
     // Clear UCSZ02
@@ -89,6 +380,12 @@ uart_status_t uart0_init(const uart0_config_t *cfg)
     case UART_DATABITS_8:
         UCSR0C |= (1 << UCSZ01) | (1 << UCSZ00); // UCSZ01=1, UCSZ00=1
         break;
+#if UART0_9BIT
+    case UART_DATABITS_9:
+        UCSR0B |= (1 << UCSZ02);
+        UCSR0C |= (1 << UCSZ01) | (1 << UCSZ00); // UCSZ02:0 = 111
+        break;
+#endif
     default:
         return UART_ERR_PARAM;
     }
@@ -105,32 +402,91 @@ uart_status_t uart0_init(const uart0_config_t *cfg)
         UCSR0C |= (1 << UPM01);
     else if (cfg->parity == UART_PARITY_ODD)
         UCSR0C |= (1 << UPM01) | (1 << UPM00);
-    // Enable RX/TX
-    UCSR0B |= (1 << RXEN0) | (1 << TXEN0);
 
     // (Optional) Flush UDR0
     (void)UDR0;
+
+    // Enable RX/TX and the RX interrupt (UDRIE0 is set when bytes are queued)
+    UCSR0B |= (1 << RXEN0) | (1 << TXEN0) | (1 << RXCIE0);
     return UART_OK;
 }
 
 void uart0_deinit(void)
 {
-    // disable RX/TX, optionally disable interrupts
-    UCSR0B &= ~((1 << TXEN0) | (1 << RXEN0));
+    // disable RX/TX and the interrupts; bytes still queued are dropped
+    UCSR0B &= ~((1 << TXEN0) | (1 << RXEN0) | (1 << RXCIE0) | (1 << UDRIE0) | (1 << TXCIE0));
+    tx_tail = tx_head;
+#if UART0_RS485
+    uart0_rs485_disable();
+#endif
+
+    // Power-gate USART0 until the next uart0_init()
+    PRR |= (1 << PRUSART0);
+}
 
+uart_status_t uart0_flush(uint32_t timeout)
+{
+    // Ring drained, then TXC0: the last stop bit has left the shift register.
+    // TXC0 never sets if nothing was sent since init, so check tx_started.
+    uint32_t start = time_us();
+#if UART0_SLEEP_WAIT
+    uart0_ucsr0b_set(1 << TXCIE0); // wake-up on TXC0 (fires at once if already set)
+#endif
+    while (uart0_tx_busy())
+    {
+        if (time_elapsed_us(start, timeout))
+            return UART_ERR_TIMEOUT;
+        uart0_wait(uart0_tx_busy);
+    }
+    return UART_OK;
 }
 
 // ----------------- TX -----------------
-uart_status_t uart0_write_byte(uint8_t b, uint32_t timeout)
+static uart_status_t uart0_put(uart0_word_t w, uint32_t timeout)
 {
- 
-    uart_status_t st = uart0_wait_flag(&UCSR0A, (1 << UDRE0), true, timeout);
-    if (st != UART_OK)
-        return st;
-    UDR0 = b;
+    uint8_t head = tx_head;
+
+    // High speed, nothing queued, UDRIE0 off (so the ISR cannot touch UDR0):
+    // the frame ends within a few dozen cycles, wait for UDRE0 and load UDR0 here
+    if (tx_spin && head == tx_tail && !(UCSR0B & (1 << UDRIE0)))
+    {
+        if (!(UCSR0A & (1 << UDRE0)))
+        {
+            // Same deadline as the ring path (a stopped transmitter never sets UDRE0)
+            uint32_t start = time_us();
+            while (!(UCSR0A & (1 << UDRE0)))
+            {
+                if (time_elapsed_us(start, timeout))
+                    return UART_ERR_TIMEOUT;
+            }
+        }
+        uint8_t sreg = SREG;
+        cli(); // UCSR0A/B updates race with the RX ISR (MPCM0) and TX ISR (TXCIE0)
+        uart0_tx_load(w);
+        SREG = sreg;
+        return UART_OK;
+    }
+
+    uint32_t start = time_us();
+    while (uart0_tx_full())
+    {
+        if (time_elapsed_us(start, timeout))
+            return UART_ERR_TIMEOUT;
+        uart0_wait(uart0_tx_full);
+        HAL_STATS_WAIT(uart_tx_wait_max_us, start); // only runs while backpressured
+    }
+
+    tx_buf[head & UART0_TX_MASK] = w;
+    tx_head = head + 1;
+    uart0_ucsr0b_set(1 << UDRIE0);
     return UART_OK;
 }
 
+uart_status_t uart0_write_byte(uint8_t b, uint32_t timeout)
+{
+    return uart0_put(b, timeout);
+}
+
 uart_status_t uart0_write(const uint8_t *buf, size_t len, uint32_t timeout)
 {
     if (!buf && len)
@@ -158,44 +514,176 @@ uart_status_t uart0_write_str(const char *s, uint32_t timeout)
     return UART_OK;
 }
 
+// "\r\n" as two immediates, so no string literal is copied to SRAM
+static uart_status_t uart0_write_crlf(uint32_t timeout)
+{
+    uart_status_t st = uart0_write_byte('\r', timeout);
+    if (st != UART_OK)
+        return st;
+    return uart0_write_byte('\n', timeout);
+}
+
 uart_status_t uart0_write_line(const char *s, uint32_t timeout)
 {
     // write_str(s) + "\r\n"
     uart_status_t st = uart0_write_str(s, timeout);
     if (st != UART_OK)
         return st;
-    st = uart0_write_str("\r\n", timeout);
+    return uart0_write_crlf(timeout);
+}
+
+// ----------------- Flash strings -----------------
+uart_status_t uart0_write_P(const uint8_t *buf_P, size_t len, uint32_t timeout)
+{
+    if (!buf_P && len)
+        return UART_ERR_PARAM;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        uart_status_t st = uart0_write_byte(pgm_read_byte(buf_P + i), timeout);
+        if (st != UART_OK)
+            return st;
+    }
+    return UART_OK;
+}
+
+uart_status_t uart0_write_str_P(const char *s_P, uint32_t timeout)
+{
+    if (!s_P)
+        return UART_ERR_PARAM;
+
+    uint8_t c;
+    while ((c = pgm_read_byte(s_P++)) != 0)
+    {
+        uart_status_t st = uart0_write_byte(c, timeout);
+        if (st != UART_OK)
+            return st;
+    }
+    return UART_OK;
+}
+
+uart_status_t uart0_write_line_P(const char *s_P, uint32_t timeout)
+{
+    uart_status_t st = uart0_write_str_P(s_P, timeout);
     if (st != UART_OK)
         return st;
+    return uart0_write_crlf(timeout);
+}
+
+// ----------------- Number formatting -----------------
+// Decimal digits by repeated subtraction of powers of ten (at most 9 per digit):
+// a 32-bit subtract is a few cycles, a 32-bit division is several hundred.
+static const uint32_t uart0_pow10[] PROGMEM = {
+    1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL,
+    10000UL, 1000UL, 100UL, 10UL
+};
+
+uart_status_t uart0_write_u32(uint32_t v, uint32_t timeout)
+{
+    bool started = false;
+
+    for (uint8_t i = 0; i < sizeof(uart0_pow10) / sizeof(uart0_pow10[0]); i++)
+    {
+        uint32_t p = pgm_read_dword(&uart0_pow10[i]);
+        uint8_t d = 0;
+        while (v >= p)
+        {
+            v -= p;
+            d++;
+        }
+        if (d || started)
+        {
+            uart_status_t st = uart0_write_byte((uint8_t)('0' + d), timeout);
+            if (st != UART_OK)
+                return st;
+            started = true;
+        }
+    }
+    return uart0_write_byte((uint8_t)('0' + v), timeout); // units (also the lone "0")
+}
+
+uart_status_t uart0_write_i32(int32_t v, uint32_t timeout)
+{
+    if (v < 0)
+    {
+        uart_status_t st = uart0_write_byte('-', timeout);
+        if (st != UART_OK)
+            return st;
+        return uart0_write_u32((uint32_t)0 - (uint32_t)v, timeout); // INT32_MIN safe
+    }
+    return uart0_write_u32((uint32_t)v, timeout);
+}
+
+uart_status_t uart0_write_hex(uint32_t v, uint8_t digits, uint32_t timeout)
+{
+    if (digits == 0 || digits > 8)
+        return UART_ERR_PARAM;
+
+    for (int8_t shift = (int8_t)((digits - 1) * 4); shift >= 0; shift -= 4)
+    {
+        uint8_t n = (uint8_t)((v >> shift) & 0x0F);
+        uart_status_t st = uart0_write_byte((uint8_t)(n < 10 ? '0' + n : 'A' - 10 + n), timeout);
+        if (st != UART_OK)
+            return st;
+    }
     return UART_OK;
 }
 
-// ----------------- RX -----------------
-// ----------------- RX -----------------
-uart_status_t uart0_read_byte(uint8_t *out, uint32_t timeout)
+size_t uart0_write_nb(const uint8_t *buf, size_t len)
 {
-    if (!out) return UART_ERR_PARAM;
+    if (!buf)
+        return 0;
 
-    // Wait for data available (RXC0 = 1)
-    uart_status_t st = uart0_wait_flag(&UCSR0A, (1 << RXC0), true, timeout);
-    if (st != UART_OK) return st;
+    uint8_t head = tx_head;
+    uint8_t space = (uint8_t)(UART0_TX_BUFFER_SIZE - (uint8_t)(head - tx_tail));
+    if (len > space)
+        len = space;
 
-    // Check errors BEFORE reading UDR0
-    // Datasheet note: FE0/DOR0/UPE0 are valid for the received frame in UDR0
-    uint8_t status = UCSR0A;
+    for (uint8_t i = 0; i < (uint8_t)len; i++)
+        tx_buf[(uint8_t)(head + i) & UART0_TX_MASK] = buf[i];
 
-    if (status & ((1 << FE0) | (1 << DOR0) | (1 << UPE0))) {
-        // Read UDR0 anyway to clear RXC0 and flush the bad byte
-        (void)UDR0;
+    if (len)
+    {
+        tx_head = (uint8_t)(head + len); // publish all bytes at once
+        uart0_ucsr0b_set(1 << UDRIE0);
+    }
+    return len;
+}
 
+// ----------------- RX -----------------
+static uart_status_t uart0_get(uart0_word_t *out, uint32_t timeout)
+{
+    // Report frames the ISR dropped (FE0/DOR0/UPE0 or ring overflow) once
+    uint8_t errs = rx_err_count;
+    if (errs != rx_err_seen) {
+        rx_err_seen = errs;
         return UART_ERR_HW;
     }
 
-    // 4) Read data (this clears RXC0)
-    *out = UDR0;
+    // Wait for data in the ring
+    uint8_t tail = rx_tail;
+    uint32_t start = time_us();
+    while (uart0_rx_empty()) {
+        if (time_elapsed_us(start, timeout)) return UART_ERR_TIMEOUT;
+        uart0_wait(uart0_rx_empty);
+    }
+
+    *out = rx_buf[tail & UART0_RX_MASK];
+    rx_tail = tail + 1;
     return UART_OK;
 }
 
+uart_status_t uart0_read_byte(uint8_t *out, uint32_t timeout)
+{
+    if (!out) return UART_ERR_PARAM;
+
+    uart0_word_t w;
+    uart_status_t st = uart0_get(&w, timeout);
+    if (st == UART_OK)
+        *out = (uint8_t)w;
+    return st;
+}
+
 
 uart_status_t uart0_read(uint8_t *buf, size_t len, uint32_t timeout)
 {
@@ -210,3 +698,127 @@ uart_status_t uart0_read(uint8_t *buf, size_t len, uint32_t timeout)
     }
     return UART_OK;
 }
+
+size_t uart0_read_nb(uint8_t *buf, size_t len)
+{
+    if (!buf)
+        return 0;
+
+    uint8_t tail = rx_tail;
+    uint8_t avail = (uint8_t)(rx_head - tail);
+    if (len > avail)
+        len = avail;
+
+    for (uint8_t i = 0; i < (uint8_t)len; i++)
+        buf[i] = (uint8_t)rx_buf[(uint8_t)(tail + i) & UART0_RX_MASK];
+
+    rx_tail = (uint8_t)(tail + len); // release all slots at once
+    return len;
+}
+
+// ----------------- Status helpers -----------------
+bool uart0_tx_ready(void)
+{
+    return tx_count() < UART0_TX_BUFFER_SIZE;
+}
+
+bool uart0_rx_ready(void)
+{
+    return rx_count() != 0;
+}
+
+uint8_t uart0_rx_available(void)
+{
+    return rx_count();
+}
+
+uint8_t uart0_tx_free(void)
+{
+    return (uint8_t)(UART0_TX_BUFFER_SIZE - tx_count());
+}
+
+// ----------------- RX notification -----------------
+void uart0_set_rx_callback(uart0_rx_cb_t cb)
+{
+    // Pointer store is two bytes: keep the ISR from seeing half of it
+    uint8_t sreg = SREG;
+    cli();
+    rx_cb = cb;
+    SREG = sreg;
+}
+
+#if UART0_9BIT
+// ----------------- 9-bit / multiprocessor -----------------
+uart_status_t uart0_write9(uint16_t w, uint32_t timeout)
+{
+    return uart0_put(w & 0x1FF, timeout);
+}
+
+uart_status_t uart0_read9(uint16_t *out, uint32_t timeout)
+{
+    if (!out) return UART_ERR_PARAM;
+    return uart0_get(out, timeout);
+}
+
+uart_status_t uart0_mpcm_enable(uint8_t addr, uint8_t broadcast)
+{
+    if (!(UCSR0B & (1 << UCSZ02)))
+        return UART_ERR_PARAM; // needs UART_DATABITS_9
+
+    uint8_t sreg = SREG;
+    cli();
+    mpcm_addr = addr;
+    mpcm_bcast = broadcast;
+    mpcm_on = true;
+    uart0_mpcm_write(true); // wait for our address
+    SREG = sreg;
+    return UART_OK;
+}
+
+void uart0_mpcm_disable(void)
+{
+    uint8_t sreg = SREG;
+    cli();
+    mpcm_on = false;
+    uart0_mpcm_write(false);
+    SREG = sreg;
+}
+
+bool uart0_mpcm_addressed(void)
+{
+    return !(UCSR0A & (1 << MPCM0));
+}
+#endif
+
+#if UART0_RS485
+// ----------------- RS-485 driver enable -----------------
+bool uart0_rs485_enable(gpio_pin_t de, bool active_high)
+{
+    if (de > PIN_A5)
+        return false;
+
+    uart0_rs485_disable();
+
+    // Receive direction first, then make it an output
+    gpio_write(de, active_high ? GPIO_LOW : GPIO_HIGH);
+    gpio_pin_mode(de, GPIO_OUTPUT);
+
+    uint8_t sreg = SREG;
+    cli();
+    de_port = &GPIO_FAST_PORT(de);
+    de_mask = GPIO_FAST_MASK(de);
+    de_active = active_high ? de_mask : 0;
+    SREG = sreg;
+    return true;
+}
+
+void uart0_rs485_disable(void)
+{
+    uint8_t sreg = SREG;
+    cli();
+    if (de_mask)
+        uart0_de_set(false); // back to receive, even mid-frame
+    de_mask = 0;
+    SREG = sreg;
+}
+#endif
@@ -4,16 +4,85 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include <avr/pgmspace.h>
+#include "timebase.h"
+#if UART0_RS485
+#include "gpio.h"
+#endif
 
 #ifndef F_CPU
 #define F_CPU 16000000UL
 #endif
 
+// Ring buffer sizes (power of two, 2..128). RX is filled by USART_RX_vect,
+// TX is drained by USART_UDRE_vect.
+#ifndef UART0_RX_BUFFER_SIZE
+#define UART0_RX_BUFFER_SIZE 64
+#endif
+
+#ifndef UART0_TX_BUFFER_SIZE
+#define UART0_TX_BUFFER_SIZE 64
+#endif
+
+// Optional packet framing in the RX path (see uart0_frame.h). When enabled,
+// the RX ISR decodes frames instead of filling the byte ring.
+#define UART0_FRAMING_NONE 0
+#define UART0_FRAMING_COBS 1
+#define UART0_FRAMING_SLIP 2
+
+#ifndef UART0_FRAMING
+#define UART0_FRAMING UART0_FRAMING_NONE
+#endif
+
+// Blocking calls sleep (SLEEP_MODE_IDLE) instead of spinning while they wait
+// for RXC0/UDRE0/TXC0, woken by the USART interrupts. Same API and timeouts;
+// only applies while global interrupts are enabled.
+#ifndef UART0_SLEEP_WAIT
+#define UART0_SLEEP_WAIT 0
+#endif
+
+// 9-bit frames (UART_DATABITS_9) and multiprocessor mode. The rings then hold
+// 16-bit words (twice the SRAM); the byte calls send bit 8 = 0 and drop it on RX.
+#ifndef UART0_9BIT
+#define UART0_9BIT 0
+#endif
+
+// RS-485 half duplex: a GPIO driver-enable (DE, usually tied to /RE) is
+// switched on before the first frame and off from USART_TX_vect once TXC0
+// reports the line idle, so no caller ever has to flush before releasing it.
+// DE is written from USART_TX_vect, so while RS-485 is enabled every other
+// write to DE's port must be atomic (gpio_write()/gpio_group_*(), gpio_fast
+// SBI/CBI, or under cli()). A plain PORTx read-modify-write that races the
+// final DE-off writes DE back on, and no later TXC0 corrects it: the
+// transceiver then drives the bus until this node transmits again.
+#ifndef UART0_RS485
+#define UART0_RS485 0
+#endif
+
+// Largest baud rate error uart0_init() accepts, in 0.1 % units. 115200 @16 MHz
+// is 2.1 % off at best (U2X, UBRR = 16), so the default leaves room for it;
+// both ends' errors add up, keep the sum under ~4 % for 8N1.
+#ifndef UART0_BAUD_TOL_PERMILLE
+#define UART0_BAUD_TOL_PERMILLE 25
+#endif
+
+// At or above this speed (frame of at most this many CPU cycles) a blocking
+// write into an empty TX ring waits for UDRE0 and loads UDR0 itself: cheaper
+// than an ISR entry per byte. 200 = 800 kbaud @16 MHz.
+#ifndef UART0_TX_SPIN_CYCLES
+#define UART0_TX_SPIN_CYCLES 200
+#endif
+
+// Timeouts are in microseconds (per byte for the multi-byte calls),
+// measured on the shared Timer0 timebase. UART0_TIMEOUT_FOREVER waits forever.
+#define UART0_TIMEOUT_FOREVER TIME_FOREVER
+
 typedef enum {
     UART_OK = 0,
     UART_ERR_PARAM,
     UART_ERR_TIMEOUT,
-    UART_ERR_HW
+    UART_ERR_HW,
+    UART_ERR_BAUD       // no UBRR/U2X within UART0_BAUD_TOL_PERMILLE of the baud rate
 } uart_status_t;
 
 typedef enum {
@@ -31,23 +100,87 @@ typedef enum {
     UART_DATABITS_5 = 5,
     UART_DATABITS_6 = 6,
     UART_DATABITS_7 = 7,
-    UART_DATABITS_8 = 8
-    // optionally add 9 bits later
+    UART_DATABITS_8 = 8,
+    UART_DATABITS_9 = 9           // needs UART0_9BIT
 } uart_databits_t;
 
+typedef enum {
+    UART_U2X_OFF = 0,             // same as false
+    UART_U2X_ON  = 1,             // same as true
+    UART_U2X_AUTO                 // whichever gives the lower baud error
+} uart_u2x_t;
+
 typedef struct {
     uint32_t baud;
     uart_databits_t databits;     // default 8
     uart_parity_t parity;         // default none
     uart_stopbits_t stopbits;     // default 1
-    bool use_u2x;                 // true: U2X0=1 (most common baud rates will be more accurates)
+    uart_u2x_t use_u2x;           // UART_U2X_AUTO: lowest baud error (false/true still accepted)
 } uart0_config_t;
 
+// Baud generator setting: UBRR0, U2X0 and the resulting error
+typedef struct {
+    uint16_t ubrr;
+    bool u2x;
+    int16_t err_permille;         // (actual - requested) / requested, 0.1 % units
+} uart0_baud_t;
+
+// Rounded UBRR for one U2X setting. Inline (like uart0_init) so a constant
+// baud rate folds to constants at compile time.
+static inline __attribute__((always_inline)) uart0_baud_t uart0_baud_calc(uint32_t baud, bool u2x)
+{
+    uart0_baud_t b = { 0x0FFF, u2x, INT16_MAX };
+    uint32_t div = (u2x ? 8UL : 16UL) * baud;
+    if (baud == 0 || div > F_CPU)
+        return b;                 // faster than the divider allows
+
+    uint32_t n = (F_CPU + div / 2UL) / div; // round(F_CPU / div) >= 1
+    if (n > 0x1000UL)
+        n = 0x1000UL;             // 12-bit UBRR limit
+    b.ubrr = (uint16_t)(n - 1UL);
+
+    uint32_t actual = F_CPU / ((u2x ? 8UL : 16UL) * n);
+    b.err_permille = (int16_t)((int32_t)((actual * 1000UL + baud / 2UL) / baud) - 1000);
+    return b;
+}
+
+// Setting for a U2X mode; AUTO takes the smaller error (normal speed on a tie:
+// 16 samples per bit tolerate more receiver error)
+static inline __attribute__((always_inline)) uart0_baud_t uart0_baud_select(uint32_t baud, uart_u2x_t mode)
+{
+    if (mode != UART_U2X_AUTO)
+        return uart0_baud_calc(baud, mode != UART_U2X_OFF);
+
+    uart0_baud_t n = uart0_baud_calc(baud, false);
+    uart0_baud_t d = uart0_baud_calc(baud, true);
+    int16_t en = n.err_permille < 0 ? (int16_t)-n.err_permille : n.err_permille;
+    int16_t ed = d.err_permille < 0 ? (int16_t)-d.err_permille : d.err_permille;
+    return ed < en ? d : n;
+}
+
 // ---------- Core ----------
-uart_status_t uart0_init(const uart0_config_t *cfg);
-void          uart0_deinit(void);
+// The driver is interrupt-driven: call sei() after uart0_init().
+// With global interrupts disabled the blocking calls fall back to polling.
+// uart0_init() picks UBRR0/U2X0 inline (constant config: no division at run
+// time) and fails with UART_ERR_BAUD beyond UART0_BAUD_TOL_PERMILLE.
+// Up to 2 Mbaud @16 MHz (U2X, UBRR = 0); 250k/500k/1M/2M are exact.
+uart_status_t uart0_init_baud(const uart0_config_t *cfg, uart0_baud_t baud); // baud->ubrr/u2x as given
+void          uart0_deinit(void);                  // drops unsent bytes (see uart0_flush()), gates USART0 clock
+uint16_t      uart0_calc_ubrr(uint32_t baud, bool u2x); // rounded UBRR0 value for F_CPU
+
+static inline __attribute__((always_inline)) uart_status_t uart0_init(const uart0_config_t *cfg)
+{
+    if (!cfg || cfg->baud == 0)
+        return UART_ERR_PARAM;
+
+    uart0_baud_t b = uart0_baud_select(cfg->baud, cfg->use_u2x);
+    if (b.err_permille > UART0_BAUD_TOL_PERMILLE || b.err_permille < -UART0_BAUD_TOL_PERMILLE)
+        return UART_ERR_BAUD;
+    return uart0_init_baud(cfg, b);
+}
+uart_status_t uart0_flush(uint32_t timeout);       // wait until the last byte left the shifter
 
-// ---------- TX (blocking/polling) ----------
+// ---------- TX (blocking, waits for ring space) ----------
 uart_status_t uart0_write_byte(uint8_t b, uint32_t timeout);
 uart_status_t uart0_write(const uint8_t *buf, size_t len, uint32_t timeout);
 
@@ -55,12 +188,66 @@ uart_status_t uart0_write(const uint8_t *buf, size_t len, uint32_t timeout);
 uart_status_t uart0_write_str(const char *s, uint32_t timeout);
 uart_status_t uart0_write_line(const char *s, uint32_t timeout); // append "\r\n"
 
-// ---------- RX (blocking/polling) ----------
+// Flash-resident (PROGMEM) variants: the text never gets copied to SRAM
+uart_status_t uart0_write_P(const uint8_t *buf_P, size_t len, uint32_t timeout);
+uart_status_t uart0_write_str_P(const char *s_P, uint32_t timeout);
+uart_status_t uart0_write_line_P(const char *s_P, uint32_t timeout);
+
+// String literal kept in flash, for the _P calls: uart0_write_line_P(UART0_STR("boot"), t)
+#define UART0_STR(s)             PSTR(s)
+#define UART0_PRINT(s, timeout)   uart0_write_str_P(PSTR(s), (timeout))
+#define UART0_PRINTLN(s, timeout) uart0_write_line_P(PSTR(s), (timeout))
+
+// Number output without printf (no vfprintf, no division)
+uart_status_t uart0_write_u32(uint32_t v, uint32_t timeout);
+uart_status_t uart0_write_i32(int32_t v, uint32_t timeout);
+uart_status_t uart0_write_hex(uint32_t v, uint8_t digits, uint32_t timeout); // 1..8 digits, no prefix
+
+// ---------- RX (blocking, waits for ring data) ----------
+// Frames received with FE0/DOR0/UPE0 (or while the ring was full) are dropped
+// by the ISR; the next read reports them once as UART_ERR_HW.
 uart_status_t uart0_read_byte(uint8_t *out, uint32_t timeout);
 uart_status_t uart0_read(uint8_t *buf, size_t len, uint32_t timeout);
 
+// ---------- Non-blocking ----------
+// Queue/dequeue as many bytes as fit right now, return the count (never waits).
+size_t uart0_write_nb(const uint8_t *buf, size_t len);
+size_t uart0_read_nb(uint8_t *buf, size_t len);
+
+// ---------- RX notification ----------
+// Called from USART_RX_vect after each byte reaches the RX ring (not with
+// UART0_FRAMING, see uart0_frame_set_callback). Keep it short, e.g. sched_post().
+typedef void (*uart0_rx_cb_t)(void);
+void uart0_set_rx_callback(uart0_rx_cb_t cb);
+
+#if UART0_9BIT
+// ---------- 9-bit frames / multiprocessor (MPCM) ----------
+// Words are 0x000..0x1FF; bit 8 set marks an address frame on a shared bus.
+uart_status_t uart0_write9(uint16_t w, uint32_t timeout);
+uart_status_t uart0_read9(uint16_t *out, uint32_t timeout);
+#define uart0_write_address(addr, timeout) uart0_write9((uint16_t)(0x100 | (uint8_t)(addr)), (timeout))
+
+// While not addressed the hardware drops data frames without an interrupt;
+// the RX ISR opens the gate on an address frame equal to addr or broadcast
+// (which is queued, bit 8 set, to mark the start of a message) and closes it
+// on any other address. UART_ERR_PARAM unless configured for 9 data bits.
+uart_status_t uart0_mpcm_enable(uint8_t addr, uint8_t broadcast);
+void          uart0_mpcm_disable(void);   // receive every frame again
+bool          uart0_mpcm_addressed(void); // data frames are currently accepted
+#endif
+
+#if UART0_RS485
+// ---------- RS-485 driver enable ----------
+// de: pin driving DE (and /RE); active_high: level that enables the driver.
+// The pin is switched by the TX path and USART_TX_vect; leave it alone meanwhile.
+bool uart0_rs485_enable(gpio_pin_t de, bool active_high); // false for a bad pin
+void uart0_rs485_disable(void);                          // driver off now (also uart0_deinit)
+#endif
+
 // ---------- Status helpers ----------
-static inline bool uart0_tx_ready(void); // UDRE0
-static inline bool uart0_rx_ready(void); // RXC0
+bool    uart0_tx_ready(void);     // TX ring has room for one byte
+bool    uart0_rx_ready(void);     // RX ring holds at least one byte
+uint8_t uart0_rx_available(void); // bytes waiting in the RX ring
+uint8_t uart0_tx_free(void);      // free slots in the TX ring
 
 #endif
@@ -0,0 +1,241 @@
+// Incremental COBS/SLIP decoder for the UART0 RX ISR.
+//   1) Pool:
+//      - UART0_FRAME_POOL buffers used as a ring of frames: the ISR decodes into
+//        pool[head], publishes it by bumping frame_head; the application reads
+//        pool[tail] in place and releases it by bumping frame_tail (SPSC, no cli()).
+//
+//   2) Decoding (one call per received byte, ISR context):
+//      - COBS: a code byte n means "n-1 data bytes follow, then a zero unless n == 0xFF".
+//        That zero is only written once the next code byte arrives, so the implicit
+//        trailing zero of the last block is never stored.
+//      - SLIP: END closes the frame, ESC selects ESC_END/ESC_ESC for the next byte.
+//      - CRC-16/XMODEM runs over every decoded byte; with the big-endian CRC appended
+//        the residue of a good frame is 0, so no look-ahead is needed.
+
+#include "uart0_frame.h"
+
+#if UART0_FRAMING != UART0_FRAMING_NONE
+
+#include <util/crc16.h>
+#include <avr/cpufunc.h>
+
+#if (UART0_FRAME_POOL < 1) || (UART0_FRAME_POOL > 128) || (UART0_FRAME_POOL & (UART0_FRAME_POOL - 1))
+#error "UART0_FRAME_POOL must be a power of two in 1..128"
+#endif
+#if (UART0_FRAME_MAX < 1) || (UART0_FRAME_MAX > 255)
+#error "UART0_FRAME_MAX must be in 1..255"
+#endif
+
+#define FRAME_MASK (UART0_FRAME_POOL - 1)
+
+#define SLIP_END     0xC0
+#define SLIP_ESC     0xDB
+#define SLIP_ESC_END 0xDC
+#define SLIP_ESC_ESC 0xDD
+
+typedef struct {
+    uint8_t len;
+    uint8_t data[UART0_FRAME_MAX];
+} uart0_frame_buf_t;
+
+static uart0_frame_buf_t frame_pool[UART0_FRAME_POOL];
+static volatile uint8_t frame_head;     // written by ISR
+static volatile uint8_t frame_tail;     // written by main
+static uart0_frame_cb_t frame_cb;
+static volatile uart0_frame_stats_t frame_stats;
+
+enum {
+    DISCARD_NONE = 0,
+    DISCARD_MALFORMED,  // counted as malformed at the delimiter
+    DISCARD_NO_BUFFER   // already counted as no_buffer
+};
+
+// Decoder state (ISR only)
+static uint8_t dec_pos;
+static uint8_t dec_discard;     // DISCARD_*, skip bytes up to the next delimiter
+static uint16_t dec_crc;
+#if UART0_FRAMING == UART0_FRAMING_COBS
+static uint8_t dec_code;        // current COBS code byte, 0 = none yet
+static uint8_t dec_left;        // data bytes left in this block
+#else
+static bool dec_esc;
+#endif
+
+static inline void frame_reset(void)
+{
+    dec_pos = 0;
+    dec_discard = DISCARD_NONE;
+    dec_crc = 0;
+#if UART0_FRAMING == UART0_FRAMING_COBS
+    dec_code = 0;
+    dec_left = 0;
+#else
+    dec_esc = false;
+#endif
+}
+
+// Append one decoded byte to the frame being built
+static inline void frame_put(uint8_t b)
+{
+    if (dec_pos >= UART0_FRAME_MAX)
+    {
+        dec_discard = DISCARD_MALFORMED;
+        return;
+    }
+    frame_pool[frame_head & FRAME_MASK].data[dec_pos++] = b;
+#if UART0_FRAME_CRC
+    dec_crc = _crc_xmodem_update(dec_crc, b);
+#endif
+}
+
+// Delimiter seen: publish or drop the frame, then start over
+static void frame_end(bool well_formed)
+{
+    if (dec_discard == DISCARD_NO_BUFFER)
+    {
+        // counted when the frame started
+    }
+    else if (dec_discard || !well_formed)
+    {
+        frame_stats.malformed++;
+    }
+    else if (dec_pos != 0)
+    {
+        uint8_t len = dec_pos;
+#if UART0_FRAME_CRC
+        if (len < 2 || dec_crc != 0)
+        {
+            frame_stats.crc++;
+            frame_reset();
+            return;
+        }
+        len -= 2;
+#endif
+        uint8_t head = frame_head;
+        frame_pool[head & FRAME_MASK].len = len;
+        _MemoryBarrier(); // frame contents before the index that publishes them
+        frame_head = head + 1;
+        frame_stats.ok++;
+        if (frame_cb)
+            frame_cb();
+    }
+    frame_reset();
+}
+
+void uart0_frame_rx(uint8_t b)
+{
+#if UART0_FRAMING == UART0_FRAMING_COBS
+    if (b == 0x00)
+    {
+        // Complete only on a block boundary; a lone delimiter is just idle
+        if (dec_code == 0 && !dec_discard)
+            frame_reset();
+        else
+            frame_end(dec_left == 0);
+        return;
+    }
+#else
+    if (b == SLIP_END)
+    {
+        if (dec_pos == 0 && !dec_discard && !dec_esc)
+            frame_reset(); // back-to-back END
+        else
+            frame_end(!dec_esc);
+        return;
+    }
+#endif
+
+    if (dec_discard)
+        return;
+
+    // No free buffer: drop the whole frame
+    if (dec_pos == 0 && (uint8_t)(frame_head - frame_tail) >= UART0_FRAME_POOL)
+    {
+        frame_stats.no_buffer++;
+        dec_discard = DISCARD_NO_BUFFER;
+        return;
+    }
+
+#if UART0_FRAMING == UART0_FRAMING_COBS
+    if (dec_left == 0)
+    {
+        if (dec_code != 0 && dec_code != 0xFF)
+            frame_put(0x00);
+        dec_code = b;
+        dec_left = (uint8_t)(b - 1);
+    }
+    else
+    {
+        frame_put(b);
+        dec_left--;
+    }
+#else
+    if (dec_esc)
+    {
+        dec_esc = false;
+        if (b == SLIP_ESC_END)
+            b = SLIP_END;
+        else if (b == SLIP_ESC_ESC)
+            b = SLIP_ESC;
+        else
+        {
+            dec_discard = DISCARD_MALFORMED;
+            return;
+        }
+        frame_put(b);
+    }
+    else if (b == SLIP_ESC)
+    {
+        dec_esc = true;
+    }
+    else
+    {
+        frame_put(b);
+    }
+#endif
+}
+
+void uart0_frame_rx_error(void)
+{
+    if (!dec_discard)
+        dec_discard = DISCARD_MALFORMED;
+}
+
+// ----------------- Application side -----------------
+void uart0_frame_set_callback(uart0_frame_cb_t cb)
+{
+    frame_cb = cb;
+}
+
+const uint8_t *uart0_frame_get(uint8_t *len)
+{
+    uint8_t tail = frame_tail;
+    if (frame_head == tail)
+        return NULL;
+    _MemoryBarrier();
+
+    uart0_frame_buf_t *f = &frame_pool[tail & FRAME_MASK];
+    if (len)
+        *len = f->len;
+    return f->data;
+}
+
+void uart0_frame_release(void)
+{
+    uint8_t tail = frame_tail;
+    if (frame_head != tail)
+        frame_tail = tail + 1;
+}
+
+void uart0_frame_get_stats(uart0_frame_stats_t *out)
+{
+    if (!out)
+        return;
+    // Single bytes written by the ISR: each copy is atomic on its own
+    out->ok = frame_stats.ok;
+    out->crc = frame_stats.crc;
+    out->malformed = frame_stats.malformed;
+    out->no_buffer = frame_stats.no_buffer;
+}
+
+#endif // UART0_FRAMING
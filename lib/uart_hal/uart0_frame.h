@@ -0,0 +1,51 @@
+#ifndef UART0_FRAME_H
+#define UART0_FRAME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart0.h"
+
+// Whole-frame RX on top of UART0 (build with -DUART0_FRAMING=UART0_FRAMING_COBS
+// or UART0_FRAMING_SLIP). The RX ISR decodes each byte as it arrives into one
+// buffer of a small pool; a finished frame is handed out by pointer (no copy)
+// and the callback fires once per frame instead of once per byte.
+//   COBS: frames end with 0x00.
+//   SLIP: frames end with 0xC0 (RFC 1055 escapes 0xDB 0xDC / 0xDB 0xDD).
+// A line error or an oversized/malformed frame discards bytes up to the next delimiter.
+
+#ifndef UART0_FRAME_MAX
+#define UART0_FRAME_MAX 64      // decoded bytes per frame (CRC included)
+#endif
+
+#ifndef UART0_FRAME_POOL
+#define UART0_FRAME_POOL 2      // frame buffers (power of two)
+#endif
+
+// 1: last two decoded bytes are CRC-16/XMODEM (big-endian) over the payload;
+// bad frames are dropped and the CRC is not part of the returned length
+#ifndef UART0_FRAME_CRC
+#define UART0_FRAME_CRC 0
+#endif
+
+typedef void (*uart0_frame_cb_t)(void); // ISR context, one call per complete frame
+
+typedef struct {
+    uint8_t ok;         // frames delivered
+    uint8_t crc;        // dropped: CRC mismatch
+    uint8_t malformed;  // dropped: too long, bad escape/code, line error
+    uint8_t no_buffer;  // dropped: every pool buffer still held by the application
+} uart0_frame_stats_t;
+
+void uart0_frame_set_callback(uart0_frame_cb_t cb);
+
+// Oldest complete frame, or NULL. Stays valid until uart0_frame_release().
+const uint8_t *uart0_frame_get(uint8_t *len);
+void           uart0_frame_release(void);
+
+void uart0_frame_get_stats(uart0_frame_stats_t *out);
+
+// ---------- Internal: fed by USART_RX_vect ----------
+void uart0_frame_rx(uint8_t b);
+void uart0_frame_rx_error(void);
+
+#endif
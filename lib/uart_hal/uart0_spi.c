@@ -0,0 +1,138 @@
+// USART0 in Master SPI mode (ATmega328P datasheet 20):
+//   1) Setup order:
+//      - UBRR0 = 0, XCK0 output (master), UMSEL0 = 11 + mode bits, RXEN0/TXEN0, then the
+//        real UBRR0: the datasheet requires the baud register to be written after TX is on.
+//
+//   2) Bursts:
+//      - TX only: the receiver is switched off (which also flushes its FIFO), UDR0 is
+//        reloaded on every UDRE0, so the next byte is always queued behind the shifter.
+//      - TXC0 sets whenever the shifter runs dry, so a stall mid-burst (an ISR is longer than
+//        one byte at f_osc/2) sets it too. It is cleared together with the last UDR0 write,
+//        under cli() as in uart0_tx_load(): only then does it mark the end of the burst.
+//      - Full duplex: at most two bytes in flight (UDR0 + shifter). The RX FIFO holds two
+//        plus the shift register, so RX can never overrun however late it is read.
+
+#include "uart0_spi.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#define UART0_SPI_PIN_XCK PIN_D4
+#define UART0_SPI_MAX_IN_FLIGHT 2
+
+static const uart0_spi_device_t *uspi_active;
+
+static inline void uspi_wait(uint8_t flag)
+{
+    while (!(UCSR0A & (1 << flag)))
+    {
+        ;
+    }
+}
+
+void uart0_spi_init(void)
+{
+    PRR &= (uint8_t)~(1 << PRUSART0);
+
+    // uart0 ISRs off: this driver polls
+    UCSR0B = 0;
+    UBRR0 = 0;
+    gpio_pin_mode(UART0_SPI_PIN_XCK, GPIO_OUTPUT); // XCK output = master
+    UCSR0C = (1 << UMSEL01) | (1 << UMSEL00);      // MSPIM, mode 0, MSB first
+    UCSR0B = (1 << RXEN0) | (1 << TXEN0);
+    UBRR0 = 1;                                     // f_osc/4
+
+    uspi_active = NULL;
+}
+
+void uart0_spi_deinit(void)
+{
+    UCSR0B = 0;
+    UCSR0C = (1 << UCSZ01) | (1 << UCSZ00); // reset value: async 8N1
+    gpio_pin_mode(UART0_SPI_PIN_XCK, GPIO_INPUT);
+    uspi_active = NULL;
+    PRR |= (1 << PRUSART0);
+}
+
+spi_status_t uart0_spi_device_init(uart0_spi_device_t *dev, gpio_pin_t cs, const spi_config_t *cfg)
+{
+    if (!dev || !cfg || cfg->mode > SPI_MODE3 || cfg->clkdiv > SPI_CLK_DIV128)
+        return SPI_ERR_PARAM;
+    if (!gpio_pin_mode(cs, GPIO_OUTPUT))
+        return SPI_ERR_PARAM;
+    gpio_write(cs, GPIO_HIGH); // deselected
+
+    dev->cs = cs;
+    dev->ucsr0c = (uint8_t)((1 << UMSEL01) | (1 << UMSEL00) |
+                            ((cfg->mode & 1) ? (1 << UCPHA0) : 0) |
+                            ((cfg->mode & 2) ? (1 << UCPOL0) : 0) |
+                            (cfg->bitorder == SPI_LSB_FIRST ? (1 << UDORD0) : 0));
+    dev->ubrr = (uint8_t)((1 << cfg->clkdiv) - 1); // DIV2 -> 0 ... DIV128 -> 63
+    return SPI_OK;
+}
+
+void uart0_spi_select(const uart0_spi_device_t *dev)
+{
+    if (dev != uspi_active)
+    {
+        // Bus is idle between calls: reconfiguring cannot cut a byte
+        UCSR0C = dev->ucsr0c;
+        UBRR0 = dev->ubrr;
+        uspi_active = dev;
+    }
+    gpio_write(dev->cs, GPIO_LOW);
+}
+
+void uart0_spi_deselect(const uart0_spi_device_t *dev)
+{
+    gpio_write(dev->cs, GPIO_HIGH);
+}
+
+uint8_t uart0_spi_transfer(uint8_t b)
+{
+    uspi_wait(UDRE0);
+    UDR0 = b;
+    uspi_wait(RXC0);
+    return UDR0;
+}
+
+void uart0_spi_transfer_buf(const uint8_t *tx, uint8_t *rx, uint16_t len)
+{
+    if (len == 0)
+        return;
+
+    if (!rx)
+    {
+        // TX only: receiver off, keep UDR0 topped up, TXC0 = last bit out
+        UCSR0B = (1 << TXEN0);
+        uint16_t last = (uint16_t)(len - 1);
+        for (uint16_t i = 0; i < last; i++)
+        {
+            uint8_t next = tx ? tx[i] : 0xFF;
+            uspi_wait(UDRE0);
+            UDR0 = next;
+        }
+        uint8_t next = tx ? tx[last] : 0xFF;
+        uspi_wait(UDRE0);
+        uint8_t sreg = SREG;
+        cli(); // clear TXC0 and queue the last byte with nothing in between
+        UCSR0A = (1 << TXC0);
+        UDR0 = next;
+        SREG = sreg;
+        uspi_wait(TXC0);
+        UCSR0B = (1 << RXEN0) | (1 << TXEN0);
+        return;
+    }
+
+    uint16_t ti = 0;
+    uint16_t ri = 0;
+    while (ri < len)
+    {
+        if (ti < len && (uint16_t)(ti - ri) < UART0_SPI_MAX_IN_FLIGHT && (UCSR0A & (1 << UDRE0)))
+        {
+            UDR0 = tx ? tx[ti] : 0xFF;
+            ti++;
+        }
+        if (UCSR0A & (1 << RXC0))
+            rx[ri++] = UDR0;
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef UART0_SPI_H
+#define UART0_SPI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "gpio.h"
+#include "spiMaster.h"
+
+// USART0 as an SPI master (MSPIM): a second SPI bus with the same device
+// configuration as spiMaster (spi_config_t / spi_mode_t / spi_clkdiv_t).
+// Unlike the SPI block, the transmitter is double buffered (UDR0 + shift
+// register), so bursts go out back to back with no gap between bytes.
+//   MOSI = TXD0 (D1), MISO = RXD0 (D0), SCK = XCK0 (D4)
+// On an Uno D0/D1 also go to the USB-serial chip through 1k resistors.
+// USART0 is either this or the asynchronous uart0 driver at any time:
+// uart0_spi_init() silences the uart0 interrupts, uart0_init() switches back
+// (asynchronous mode, XCK0/D4 released to an input).
+// All transfers are blocking and return with the bus idle.
+
+typedef struct {
+    gpio_pin_t cs;      // active low
+    uint8_t ucsr0c;     // UMSEL0 = 11, UDORD0, UCPHA0, UCPOL0
+    uint8_t ubrr;       // SCK = F_CPU / (2 * (UBRR0 + 1))
+} uart0_spi_device_t;
+
+void         uart0_spi_init(void);   // pins + MSPIM (mode 0, MSB first, f_osc/4)
+void         uart0_spi_deinit(void); // USART0 off and power-gated
+spi_status_t uart0_spi_device_init(uart0_spi_device_t *dev, gpio_pin_t cs, const spi_config_t *cfg);
+
+// Apply dev's mode/clock (only if it differs from the active one) and pull CS low
+void uart0_spi_select(const uart0_spi_device_t *dev);
+void uart0_spi_deselect(const uart0_spi_device_t *dev);
+
+uint8_t uart0_spi_transfer(uint8_t b);
+// tx == NULL sends 0xFF, rx == NULL discards what comes back (TX-only burst, no gaps)
+void    uart0_spi_transfer_buf(const uint8_t *tx, uint8_t *rx, uint16_t len);
+
+#endif
@@ -0,0 +1,86 @@
+#include "adc.h"
+#include "uart0.h"
+#include "timebase.h"
+#include <avr/interrupt.h>
+
+#define UART_TIMEOUT_US 100000UL
+
+static void print_batch(const adc_sample_t *s, uint8_t n) {
+    for (uint8_t i = 0; i < n; i++) {
+        uart0_write_u32(s[i].t_us, UART_TIMEOUT_US);
+        UART0_PRINT(" A", UART_TIMEOUT_US);
+        uart0_write_u32(s[i].channel, UART_TIMEOUT_US);
+        UART0_PRINT("=", UART_TIMEOUT_US);
+        uart0_write_u32(s[i].value, UART_TIMEOUT_US);
+        uart0_write_line_P(UART0_STR(""), UART_TIMEOUT_US);
+    }
+}
+
+// Example 1: A0 + A1 paced by the timebase overflow (~977 conversions/s, ~488 per channel)
+//            with 2 bits of oversampling: 12-bit samples at ~30 per channel per second
+void example_scan(void) {
+    adc_config_t cfg = {
+        .channels = (1 << 0) | (1 << 1),
+        .ref = ADC_REF_AVCC,
+        .trigger = ADC_TRIG_TIMER0_OVF,
+        .clkdiv = ADC_CLK_DIV128,
+        .oversample_bits = 2
+    };
+    adc_init(&cfg);
+    adc_start();
+
+    adc_sample_t batch[8];
+    while (1) {
+        uint8_t n = adc_read(batch, sizeof(batch) / sizeof(batch[0]));
+        print_batch(batch, n);
+        // ... other work: conversions keep running in the background
+    }
+}
+
+// Example 2: Free-running A0 at ~9.6 kS/s, only counting samples (printing would overrun the ring)
+void example_rate(void) {
+    adc_config_t cfg = {
+        .channels = (1 << 0),
+        .ref = ADC_REF_AVCC,
+        .trigger = ADC_TRIG_FREE_RUN,
+        .clkdiv = ADC_CLK_DIV128,
+        .oversample_bits = 0
+    };
+    adc_init(&cfg);
+    adc_start();
+
+    adc_sample_t batch[16];
+    uint32_t count = 0;
+    uint32_t last = time_ms();
+    while (1) {
+        count += adc_read(batch, sizeof(batch) / sizeof(batch[0]));
+        if (time_ms() - last >= 1000) {
+            last += 1000;
+            UART0_PRINT("samples/s=", UART_TIMEOUT_US);
+            uart0_write_u32(count, UART_TIMEOUT_US);
+            UART0_PRINT(" lost=", UART_TIMEOUT_US);
+            uart0_write_u32(adc_overruns(), UART_TIMEOUT_US);
+            uart0_write_line_P(UART0_STR(""), UART_TIMEOUT_US);
+            count = 0;
+        }
+    }
+}
+
+int main(void) {
+    uart0_config_t ucfg = {
+        .baud = 115200,
+        .databits = UART_DATABITS_8,
+        .parity = UART_PARITY_NONE,
+        .stopbits = UART_STOP_1,
+        .use_u2x = UART_U2X_AUTO
+    };
+    uart0_init(&ucfg);
+    timebase_init();
+    sei();
+
+    // Choose one example to run:
+    example_scan();      // Example 1: timer-paced two-channel scan
+    // example_rate();   // Example 2: free-running throughput
+
+    return 0;
+}
@@ -0,0 +1,35 @@
+#ifndef BENCH_IDS_H
+#define BENCH_IDS_H
+
+// Shared by the benchmark firmware (src/bench/main.c) and the simavr runner
+// (tools/bench/bench_runner.c).
+//
+// Protocol: the firmware writes the id to GPIOR0 right before the code under
+// test and to GPIOR1 right after it; the runner records the simulator cycle
+// counter on both writes. GPIOR2 carries the call's status (0 = OK) and is
+// written before GPIOR1. "ops" is the number of operations inside the pair,
+// so the runner can report cycles per op. BENCH_OVERHEAD is an empty pair,
+// subtracted from every other result.
+
+#define BENCH_I2C_ADDR  0x50    // simulated TWI slave (register file)
+#define BENCH_I2C_REG   0x10
+
+// X(id, name, ops)
+#define BENCH_LIST(X)                                    \
+    X(BENCH_OVERHEAD,        "marker_overhead",      1)  \
+    X(BENCH_GPIO_WRITE,      "gpio_write",           1)  \
+    X(BENCH_GPIO_READ,       "gpio_read",            1)  \
+    X(BENCH_GPIO_TOGGLE,     "gpio_toggle",          1)  \
+    X(BENCH_GPIO_FAST_WRITE, "gpio_fast_write",      1)  \
+    X(BENCH_GPIO_FAST_TOGGLE,"gpio_fast_toggle",     1)  \
+    X(BENCH_GPIO_GROUP_WRITE,"gpio_group_write",     1)  \
+    X(BENCH_UART_CALC_UBRR,  "uart0_calc_ubrr",      1)  \
+    X(BENCH_UART_WRITE,      "uart0_write_per_byte", 16) \
+    X(BENCH_UART_WRITE_NB,   "uart0_write_nb_per_byte", 16) \
+    X(BENCH_I2C_READ_REG,    "i2c_read_reg_6",       1)
+
+#define BENCH_ENUM(id, name, ops) id,
+enum { BENCH_LIST(BENCH_ENUM) BENCH_COUNT };
+#undef BENCH_ENUM
+
+#endif
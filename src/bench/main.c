@@ -0,0 +1,107 @@
+#include "bench_ids.h"
+#include "gpio.h"
+#include "gpio_fast.h"
+#include "uart0.h"
+#include "i2cMaster.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+// Cycle benchmarks, meant to run under simavr (tools/bench/run_bench.sh).
+// Each marker is a single OUT instruction, see bench_ids.h.
+#define BENCH_BEGIN(id)     (GPIOR0 = (id))
+#define BENCH_END(id, st)   do { GPIOR2 = (uint8_t)(st); GPIOR1 = (id); } while (0)
+
+// Inputs behind volatile so nothing is folded at compile time
+static volatile uint32_t bench_baud = 115200;
+static volatile uint8_t bench_u2x = 1;
+static volatile uint16_t bench_sink;
+
+static void bench_cpu_paths(void) {
+    static const gpio_pin_t bus[] = { PIN_D8, PIN_D9, PIN_D10, PIN_D11 };
+    static const uint8_t msg[16] = "0123456789abcdef";
+    gpio_group_t group;
+    uart_status_t st;
+
+    gpio_pin_mode(PIN_D13, GPIO_OUTPUT);
+    gpio_group_init(&group, bus, 4);
+    gpio_group_mode(&group, GPIO_OUTPUT);
+
+    BENCH_BEGIN(BENCH_OVERHEAD);
+    BENCH_END(BENCH_OVERHEAD, 0);
+
+    BENCH_BEGIN(BENCH_GPIO_WRITE);
+    bool ok = gpio_write(PIN_D13, GPIO_HIGH);
+    BENCH_END(BENCH_GPIO_WRITE, !ok);
+
+    BENCH_BEGIN(BENCH_GPIO_READ);
+    int8_t level = gpio_read(PIN_D13);
+    BENCH_END(BENCH_GPIO_READ, level < 0);
+
+    BENCH_BEGIN(BENCH_GPIO_TOGGLE);
+    ok = gpio_toggle(PIN_D13);
+    BENCH_END(BENCH_GPIO_TOGGLE, !ok);
+
+    BENCH_BEGIN(BENCH_GPIO_FAST_WRITE);
+    gpio_fast_write(PIN_D13, GPIO_HIGH);
+    BENCH_END(BENCH_GPIO_FAST_WRITE, 0);
+
+    BENCH_BEGIN(BENCH_GPIO_FAST_TOGGLE);
+    gpio_fast_toggle(PIN_D13);
+    BENCH_END(BENCH_GPIO_FAST_TOGGLE, 0);
+
+    BENCH_BEGIN(BENCH_GPIO_GROUP_WRITE);
+    gpio_group_write(&group, 0x0A);
+    BENCH_END(BENCH_GPIO_GROUP_WRITE, 0);
+
+    BENCH_BEGIN(BENCH_UART_CALC_UBRR);
+    bench_sink = uart0_calc_ubrr(bench_baud, bench_u2x);
+    BENCH_END(BENCH_UART_CALC_UBRR, 0);
+
+    // Queueing cost into an empty TX ring (the wire time is not the CPU's)
+    BENCH_BEGIN(BENCH_UART_WRITE);
+    st = uart0_write(msg, sizeof(msg), UART0_TIMEOUT_FOREVER);
+    BENCH_END(BENCH_UART_WRITE, st);
+    uart0_flush(UART0_TIMEOUT_FOREVER);
+
+    BENCH_BEGIN(BENCH_UART_WRITE_NB);
+    size_t n = uart0_write_nb(msg, sizeof(msg));
+    BENCH_END(BENCH_UART_WRITE_NB, n != sizeof(msg));
+    uart0_flush(UART0_TIMEOUT_FOREVER);
+}
+
+static void bench_i2c(void) {
+    uint8_t data[6];
+
+    // Wall-clock cycles of a 6-byte register read at 100 kHz
+    BENCH_BEGIN(BENCH_I2C_READ_REG);
+    i2c_status_t st = i2c_read_reg(BENCH_I2C_ADDR, BENCH_I2C_REG, data, sizeof(data));
+    BENCH_END(BENCH_I2C_READ_REG, st);
+}
+
+int main(void) {
+    const uart0_config_t cfg = {
+        .baud = 115200,
+        .databits = UART_DATABITS_8,
+        .parity = UART_PARITY_NONE,
+        .stopbits = UART_STOP_1,
+        .use_u2x = UART_U2X_AUTO
+    };
+    uart0_init(&cfg);
+    i2c_init();
+
+    // CPU paths with interrupts off: no timer/UART ISR lands inside a pair
+    // (uart0_flush() polls the hardware itself in that state)
+    bench_cpu_paths();
+
+    sei();
+    bench_i2c();
+
+    // Sleeping with interrupts off ends the simulation (simavr: cpu_Done)
+    cli();
+    sleep_enable();
+    sleep_cpu();
+    while (1) {
+    }
+    return 0;
+}
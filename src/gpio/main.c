@@ -1,4 +1,8 @@
 #include "gpio.h"
+#include "gpio_fast.h"
+#include "gpio_irq.h"
+#include "debounce.h"
+#include <avr/interrupt.h>
 #include <util/delay.h>
 
 // Example 1: Simple LED blink
@@ -25,7 +29,13 @@ void example_led_toggle(void) {
     }
 }
 
-// Example 3: Button reading with pull-up resistor
+// Example 3: Button reading with pull-up resistor (interrupt-driven, no polling)
+static void button_changed(gpio_pin_t pin, gpio_level_t level) {
+    (void)pin;
+    // ISR context: button is active LOW, mirror it on the LED right away
+    gpio_write(PIN_D13, level == GPIO_LOW ? GPIO_HIGH : GPIO_LOW);
+}
+
 void example_button_led(void) {
     // Configure PIN_D13 as output (LED)
     gpio_pin_mode(PIN_D13, GPIO_OUTPUT);
@@ -33,50 +43,38 @@ void example_button_led(void) {
     // Configure PIN_D2 as input with internal pull-up
     // Button should connect PIN_D2 to GND
     gpio_pin_mode(PIN_D2, GPIO_INPUT_PULLUP);
+
+    // D2 = INT0; any other pin works the same way through its PCINT bank
+    gpio_attach_interrupt(PIN_D2, GPIO_EDGE_CHANGE, button_changed);
+    sei();
     
     while (1) {
-        // Read button state (active LOW with pull-up)
-        int8_t button_state = gpio_read(PIN_D2);
-        
-        if (button_state == GPIO_LOW) {
-            // Button is pressed (connected to GND)
-            gpio_write(PIN_D13, GPIO_HIGH);
-        } else {
-            // Button is not pressed
-            gpio_write(PIN_D13, GPIO_LOW);
-        }
-        _delay_ms(10);  // Debounce delay
+        // CPU is free here; the LED follows the button within a few microseconds
+        // (contact bounce shows up as a burst of extra callbacks)
     }
 }
 
 // Example 4: Multiple LEDs control
 void example_multiple_leds(void) {
-    // Configure pins D8-D11 as outputs
-    gpio_pin_mode(PIN_D8, GPIO_OUTPUT);
-    gpio_pin_mode(PIN_D9, GPIO_OUTPUT);
-    gpio_pin_mode(PIN_D10, GPIO_OUTPUT);
-    gpio_pin_mode(PIN_D11, GPIO_OUTPUT);
+    // D8-D11 = PB0-PB3: one group, every update is a single PORTB store
+    static const gpio_pin_t leds[] = { PIN_D8, PIN_D9, PIN_D10, PIN_D11 };
+    gpio_group_t bar;
+    gpio_group_init(&bar, leds, 4);
+    gpio_group_mode(&bar, GPIO_OUTPUT);
+    gpio_group_clear(&bar);
     
     while (1) {
-        // Turn on LEDs in sequence
-        gpio_write(PIN_D8, GPIO_HIGH);
-        _delay_ms(200);
-        gpio_write(PIN_D9, GPIO_HIGH);
-        _delay_ms(200);
-        gpio_write(PIN_D10, GPIO_HIGH);
-        _delay_ms(200);
-        gpio_write(PIN_D11, GPIO_HIGH);
-        _delay_ms(200);
+        // Turn on LEDs in sequence: 0001, 0011, 0111, 1111
+        for (uint8_t i = 1; i <= 4; i++) {
+            gpio_group_write(&bar, (uint8_t)((1 << i) - 1));
+            _delay_ms(200);
+        }
         
-        // Turn off LEDs in sequence
-        gpio_write(PIN_D8, GPIO_LOW);
-        _delay_ms(200);
-        gpio_write(PIN_D9, GPIO_LOW);
-        _delay_ms(200);
-        gpio_write(PIN_D10, GPIO_LOW);
-        _delay_ms(200);
-        gpio_write(PIN_D11, GPIO_LOW);
-        _delay_ms(200);
+        // Turn off LEDs in sequence: 1110, 1100, 1000, 0000
+        for (uint8_t i = 1; i <= 4; i++) {
+            gpio_group_write(&bar, (uint8_t)(0x0F << i));
+            _delay_ms(200);
+        }
     }
 }
 
@@ -102,36 +100,70 @@ void example_sensor_reading(void) {
 
 // Example 6: Traffic light simulation
 void example_traffic_light(void) {
-    #define LED_RED   PIN_D10
-    #define LED_YELLOW PIN_D11
-    #define LED_GREEN PIN_D12
+    #define LIGHT_RED    0x01
+    #define LIGHT_YELLOW 0x02
+    #define LIGHT_GREEN  0x04
     
-    // Configure LEDs as outputs
-    gpio_pin_mode(LED_RED, GPIO_OUTPUT);
-    gpio_pin_mode(LED_YELLOW, GPIO_OUTPUT);
-    gpio_pin_mode(LED_GREEN, GPIO_OUTPUT);
+    // Red, yellow, green = D10, D11, D12; all lights switch in one store
+    static const gpio_pin_t lights[] = { PIN_D10, PIN_D11, PIN_D12 };
+    gpio_group_t light;
+    gpio_group_init(&light, lights, 3);
+    gpio_group_mode(&light, GPIO_OUTPUT);
     
     while (1) {
         // Red light
-        gpio_write(LED_RED, GPIO_HIGH);
-        gpio_write(LED_YELLOW, GPIO_LOW);
-        gpio_write(LED_GREEN, GPIO_LOW);
+        gpio_group_write(&light, LIGHT_RED);
         _delay_ms(3000);
         
         // Yellow light
-        gpio_write(LED_RED, GPIO_LOW);
-        gpio_write(LED_YELLOW, GPIO_HIGH);
-        gpio_write(LED_GREEN, GPIO_LOW);
+        gpio_group_write(&light, LIGHT_YELLOW);
         _delay_ms(1000);
         
         // Green light
-        gpio_write(LED_RED, GPIO_LOW);
-        gpio_write(LED_YELLOW, GPIO_LOW);
-        gpio_write(LED_GREEN, GPIO_HIGH);
+        gpio_group_write(&light, LIGHT_GREEN);
         _delay_ms(3000);
     }
 }
 
+// Example 7: Compile-time fast path (SBI/CBI/SBIS instead of table lookups)
+void example_fast_path(void) {
+    gpio_fast_mode(PIN_D13, GPIO_OUTPUT);
+    gpio_fast_mode(PIN_D2, GPIO_INPUT_PULLUP);
+
+    while (1) {
+        if (gpio_fast_read(PIN_D2) == GPIO_LOW) {
+            gpio_fast_toggle(PIN_D13);   // single OUT to PINB
+        } else {
+            gpio_fast_low(PIN_D13);      // single CBI
+        }
+        _delay_ms(100);
+    }
+}
+
+// Example 8: Debounced buttons on a whole port (no delays, no per-pin polling)
+void example_debounce(void) {
+    // Buttons on A0-A3 to GND, LEDs on D8-D11
+    static const gpio_pin_t buttons[] = { PIN_A0, PIN_A1, PIN_A2, PIN_A3 };
+    static const gpio_pin_t leds[] = { PIN_D8, PIN_D9, PIN_D10, PIN_D11 };
+    gpio_group_t in, out;
+    gpio_group_init(&in, buttons, 4);
+    gpio_group_init(&out, leds, 4);
+    gpio_group_mode(&in, GPIO_INPUT_PULLUP);
+    gpio_group_mode(&out, GPIO_OUTPUT);
+
+    debounce_init();
+    debounce_enable(GPIO_PORT_C, 0x0F, 0x0F); // PC0-PC3, active low
+    sei();
+
+    uint8_t leds_on = 0;
+    while (1) {
+        // Each press toggles its LED; PORTC bit i = button i
+        leds_on ^= debounce_pressed(GPIO_PORT_C);
+        gpio_group_write(&out, leds_on);
+        // ... other work
+    }
+}
+
 // Main function - uncomment the example you want to run
 int main(void) {
     // Choose one example to run:
@@ -142,6 +174,8 @@ int main(void) {
     // example_multiple_leds();    // Example 4: Multiple LEDs
     // example_sensor_reading();   // Example 5: Digital sensor
     // example_traffic_light();    // Example 6: Traffic light
+    // example_fast_path();        // Example 7: Compile-time fast path
+    // example_debounce();         // Example 8: Port-wide debouncing
     
     return 0;
 }
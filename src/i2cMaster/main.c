@@ -0,0 +1,125 @@
+#include "i2cMaster.h"
+#include "gpio.h"
+#include <avr/interrupt.h>
+#include <util/delay.h>
+
+// Example device: MPU-6050 IMU (AD0 = GND)
+#define IMU_ADDR        0x68
+#define IMU_WHO_AM_I    0x75
+#define IMU_ACCEL_XOUT  0x3B
+#define IMU_PWR_MGMT_1  0x6B
+
+// Example 1: Blocking register access (wrappers around the async engine)
+void example_blocking(void) {
+    gpio_pin_mode(PIN_D13, GPIO_OUTPUT);
+
+    uint8_t wake = 0x00;
+    i2c_write_reg(IMU_ADDR, IMU_PWR_MGMT_1, &wake, 1);
+
+    while (1) {
+        uint8_t id = 0;
+        i2c_status_t st = i2c_read_reg(IMU_ADDR, IMU_WHO_AM_I, &id, 1);
+        // LED on = device answered with the expected ID
+        gpio_write(PIN_D13, (st == I2C_OK && id == IMU_ADDR) ? GPIO_HIGH : GPIO_LOW);
+        _delay_ms(500);
+    }
+}
+
+// Example 2: Background read, the CPU keeps working while the bus is busy
+static uint8_t accel[6];
+static volatile uint8_t accel_ready;
+
+static void accel_done(i2c_xfer_t *xfer) {
+    (void)xfer;
+    accel_ready = 1; // ISR context: only flag the main loop
+}
+
+void example_async(void) {
+    gpio_pin_mode(PIN_D13, GPIO_OUTPUT);
+
+    uint8_t wake = 0x00;
+    i2c_write_reg(IMU_ADDR, IMU_PWR_MGMT_1, &wake, 1);
+
+    static i2c_xfer_t xfer = {
+        .addr7 = IMU_ADDR,
+        .flags = I2C_XFER_READ,
+        .hdr = { IMU_ACCEL_XOUT },
+        .hdr_len = 1,
+        .rbuf = accel,
+        .rlen = sizeof(accel),
+        .callback = accel_done
+    };
+    i2c_submit(&xfer);
+
+    uint16_t spins = 0;
+    while (1) {
+        if (accel_ready) {
+            accel_ready = 0;
+            if (xfer.status == I2C_OK) {
+                // accel[0..5] = X/Y/Z big-endian; blink faster when X is negative
+                gpio_toggle(PIN_D13);
+                _delay_ms((accel[0] & 0x80) ? 50 : 200);
+            }
+            i2c_submit(&xfer); // next sample
+        }
+        spins++; // ... other work runs here while the transfer is in flight
+    }
+}
+
+// Example 3: 24LC256 EEPROM (16-bit address, 100 kHz) + IMU burst (400 kHz) on one bus,
+// each transfer in one bus ownership
+#define EEPROM_ADDR 0x50
+
+static i2c_device_t eeprom;
+static i2c_device_t imu;
+
+void example_transfer(void) {
+    gpio_pin_mode(PIN_D13, GPIO_OUTPUT);
+
+    i2c_device_init(&eeprom, EEPROM_ADDR, 100000UL, 2, 5); // retry while a write cycle NACKs
+    i2c_device_init(&imu, IMU_ADDR, 400000UL, 1, 0);
+
+    uint8_t boot_count = 0;
+    i2c_dev_read_reg(&eeprom, 0x0000, &boot_count, 1);
+    boot_count++;
+    i2c_dev_write_reg(&eeprom, 0x0000, &boot_count, 1);
+
+    while (1) {
+        // Random read: address high/low, REPEATED START, 16 data bytes, one STOP
+        uint8_t mem_addr[2] = { 0x01, 0x00 };
+        uint8_t page[16];
+        i2c_msg_t eeprom_read[] = {
+            { EEPROM_ADDR, 0, sizeof(mem_addr), mem_addr },
+            { EEPROM_ADDR, I2C_M_RD, sizeof(page), page },
+        };
+        i2c_status_t st = i2c_dev_transfer(&eeprom, eeprom_read, 2);
+
+        // Accel and gyro split into two buffers without ending the read stream
+        uint8_t reg = IMU_ACCEL_XOUT;
+        uint8_t accel_temp[8]; // accel X/Y/Z + temperature
+        uint8_t gyro[6];
+        i2c_msg_t imu_read[] = {
+            { IMU_ADDR, 0, 1, &reg },
+            { IMU_ADDR, I2C_M_RD, sizeof(accel_temp), accel_temp },
+            { IMU_ADDR, I2C_M_RD | I2C_M_NOSTART, sizeof(gyro), gyro },
+        };
+        if (st == I2C_OK) {
+            st = i2c_dev_transfer(&imu, imu_read, 3); // divider reloaded only here and above
+        }
+
+        gpio_write(PIN_D13, st == I2C_OK ? GPIO_HIGH : GPIO_LOW);
+        _delay_ms(500);
+    }
+}
+
+int main(void) {
+    i2c_init();
+    sei(); // the engine runs in TWI_vect
+
+    // Choose one example to run:
+    example_blocking();   // Example 1: blocking helpers
+    // example_async();   // Example 2: background transfers
+    // example_transfer(); // Example 3: scatter-gather
+
+    return 0;
+}
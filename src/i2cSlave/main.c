@@ -0,0 +1,61 @@
+#include "i2cSlave.h"
+#include "gpio.h"
+#include "timebase.h"
+#include <avr/interrupt.h>
+
+// Example: this board as an I2C peripheral at 0x42
+//   0x00       WHO_AM_I  (read-only, 0xA5)
+//   0x01..0x04 uptime in ms, little-endian (read-only)
+//   0x10       LED control, bit 0 = D13 (read/write)
+//   0x11       command (write-only, reads 0xFF)
+#define SLAVE_ADDR   0x42
+#define REG_WHO_AM_I 0x00
+#define REG_UPTIME   0x01
+#define REG_LED      0x10
+#define REG_CMD      0x11
+#define REG_COUNT    0x12
+
+static volatile uint8_t regs[REG_COUNT];
+static volatile uint8_t led_dirty;
+
+static void on_write(uint8_t first_reg, uint8_t count) {
+    // ISR context: only flag the main loop
+    if (first_reg <= REG_LED && first_reg + count > REG_LED) {
+        led_dirty = 1;
+    }
+}
+
+int main(void) {
+    timebase_init();
+    gpio_pin_mode(PIN_D13, GPIO_OUTPUT);
+    regs[REG_WHO_AM_I] = 0xA5;
+
+    const i2c_slave_config_t cfg = {
+        .addr7 = SLAVE_ADDR,
+        .regs = regs,
+        .size = sizeof(regs),
+        .rd_first = REG_WHO_AM_I, .rd_last = REG_LED,
+        .wr_first = REG_LED,      .wr_last = REG_CMD,
+        .on_write = on_write
+    };
+    i2c_slave_init(&cfg);
+    sei(); // replies are served from TWI_vect
+
+    while (1) {
+        // Publish the 4-byte counter atomically: a host read of 0x01..0x04 is served
+        // from the copy latched at SLA+R (I2C_SLAVE_LATCH = 4), never half-updated
+        uint32_t ms = time_ms();
+        uint8_t up[4] = { (uint8_t)ms, (uint8_t)(ms >> 8), (uint8_t)(ms >> 16), (uint8_t)(ms >> 24) };
+        i2c_slave_set(REG_UPTIME, up, sizeof(up));
+
+        if (led_dirty) {
+            led_dirty = 0;
+            uint8_t led;
+            // ERR_BUSY: another write is under way, its on_write sets the flag again
+            if (i2c_slave_get(REG_LED, &led, 1) == I2C_SLAVE_OK)
+                gpio_write(PIN_D13, (led & 0x01) ? GPIO_HIGH : GPIO_LOW);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include "prof.h"
+#include "uart0.h"
+#include "timebase.h"
+#include <avr/interrupt.h>
+
+#define UART_TIMEOUT_US 100000UL
+
+// Profiled sites
+enum {
+    SITE_TIME_US = 0,   // time_us(): cli + TCNT0 read + 32-bit math
+    SITE_WRITE_U32,     // uart0_write_u32(): digit loop + TX ring (waits when the ring is full)
+    SITE_LOOP           // one main-loop pass
+};
+
+int main(void) {
+    uart0_config_t cfg = {
+        .baud = 115200,
+        .databits = UART_DATABITS_8,
+        .parity = UART_PARITY_NONE,
+        .stopbits = UART_STOP_1,
+        .use_u2x = UART_U2X_AUTO
+    };
+    uart0_init(&cfg);
+    prof_init();
+    sei();
+
+    uint32_t last = time_ms();
+    uint32_t i = 0;
+    while (1) {
+        prof_begin(SITE_LOOP);
+
+        prof_begin(SITE_TIME_US);
+        volatile uint32_t t = time_us();
+        prof_end(SITE_TIME_US);
+        (void)t;
+
+        prof_begin(SITE_WRITE_U32);
+        uart0_write_u32(i++, UART_TIMEOUT_US);
+        prof_end(SITE_WRITE_U32);
+        uart0_write_byte('\r', UART_TIMEOUT_US);
+
+        if (time_ms() - last >= 2000) {
+            last += 2000;
+            uart0_write_line_P(UART0_STR(""), UART_TIMEOUT_US);
+            prof_dump(UART_TIMEOUT_US);
+            prof_reset();
+        }
+        prof_end(SITE_LOOP);
+    }
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include "pwm.h"
+#include "timebase.h"
+#include <avr/interrupt.h>
+
+// Example 1: LED breathing on D6 (Timer0, shares the timebase clock)
+//            + motor drive on D3 (Timer2, 31.4 kHz phase correct: inaudible)
+void example_fade(void) {
+    pwm_timer2_init(PWM_PHASE_CORRECT, 1);
+    pwm_attach(PIN_D6);
+    pwm_attach(PIN_D3);
+    pwm_write(PIN_D3, 96); // ~38 % duty, runs with no CPU from here on
+
+    uint32_t last = time_ms();
+    uint8_t level = 0;
+    int8_t step = 1;
+    while (1) {
+        if (time_ms() - last >= 8) {
+            last += 8;
+            level = (uint8_t)(level + step);
+            if (level == 0 || level == 255) step = (int8_t)-step;
+            pwm_write(PIN_D6, level); // buffered: applied at the next BOTTOM
+        }
+        // ... other work
+    }
+}
+
+// Example 2: Hobby servo on D9, 50 Hz with 1 us resolution
+//   phase/frequency correct, N = 8: f = 16 MHz / (2 * 8 * 20000) = 50 Hz,
+//   pulse width in us = OCR1A
+void example_servo(void) {
+    pwm_timer1_init(PWM_PHASE_CORRECT, 8, 20000);
+    pwm_attach(PIN_D9);
+
+    while (1) {
+        for (uint16_t us = 1000; us <= 2000; us += 10) {
+            pwm_write(PIN_D9, us);
+            uint32_t t = time_ms();
+            while (time_ms() - t < 20) {
+            }
+        }
+    }
+}
+
+// Example 3: Exact 25 kHz PC-fan PWM on D10 (Timer1 picks prescaler and TOP)
+void example_fan(void) {
+    pwm_timer1_set_freq(PWM_FAST, 25000); // N = 1, TOP = 639
+    pwm_attach(PIN_D10);
+    pwm_write_scaled(PIN_D10, 0x8000);    // 50 %
+
+    while (1) {
+    }
+}
+
+int main(void) {
+    timebase_init();
+    sei();
+
+    // Choose one example to run:
+    example_fade();      // Example 1: Timer0 + Timer2
+    // example_servo();  // Example 2: Timer1 servo
+    // example_fan();    // Example 3: Timer1 exact frequency
+
+    return 0;
+}
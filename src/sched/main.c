@@ -0,0 +1,116 @@
+#include "sched.h"
+#include "gpio.h"
+#include "gpio_irq.h"
+#include "uart0.h"
+#include "i2cMaster.h"
+#include <avr/interrupt.h>
+
+// One board, four jobs, no _delay_ms():
+//   - blink D13 every 500 ms                       (periodic task)
+//   - button on D2 -> print a line                 (INT0 callback posts a task)
+//   - UART echo                                    (RX callback posts a task)
+//   - read the MPU-6050 accel every 100 ms         (periodic task starts the transfer,
+//                                                   completion callback posts a task)
+#define UART_TIMEOUT_US 100000UL
+#define IMU_ADDR        0x68
+#define IMU_ACCEL_XOUT  0x3B
+#define IMU_PWR_MGMT_1  0x6B
+
+static sched_id_t blink_task, button_task, echo_task, imu_start_task, imu_done_task;
+
+static void blink(void *arg) {
+    (void)arg;
+    gpio_toggle(PIN_D13);
+}
+
+static void button(void *arg) {
+    (void)arg;
+    UART0_PRINTLN("button", UART_TIMEOUT_US);
+}
+
+static void on_button(gpio_pin_t pin, gpio_level_t level) {
+    (void)pin;
+    if (level == GPIO_LOW) {
+        sched_post(button_task); // ISR context: just post
+    }
+}
+
+static void echo(void *arg) {
+    (void)arg;
+    uint8_t buf[16];
+    size_t n;
+    while ((n = uart0_read_nb(buf, sizeof(buf))) != 0) {
+        uart0_write_nb(buf, n);
+    }
+}
+
+static void on_rx(void) {
+    sched_post(echo_task);
+}
+
+static uint8_t accel[6];
+static i2c_xfer_t imu_xfer;
+
+static void on_imu(i2c_xfer_t *x) {
+    (void)x;
+    sched_post(imu_done_task);
+}
+
+static void imu_start(void *arg) {
+    (void)arg;
+    if (i2c_done(&imu_xfer)) {
+        i2c_submit(&imu_xfer); // runs in TWI_vect, the loop keeps going
+    }
+}
+
+static void imu_done(void *arg) {
+    (void)arg;
+    if (imu_xfer.status == I2C_OK) {
+        UART0_PRINT("ax=", UART_TIMEOUT_US);
+        uart0_write_i32((int16_t)((accel[0] << 8) | accel[1]), UART_TIMEOUT_US);
+        uart0_write_line_P(UART0_STR(""), UART_TIMEOUT_US);
+    }
+}
+
+int main(void) {
+    uart0_config_t cfg = {
+        .baud = 115200,
+        .databits = UART_DATABITS_8,
+        .parity = UART_PARITY_NONE,
+        .stopbits = UART_STOP_1,
+        .use_u2x = UART_U2X_AUTO
+    };
+    uart0_init(&cfg);
+    i2c_init();
+    uint8_t wake = 0x00;
+    i2c_write_reg(IMU_ADDR, IMU_PWR_MGMT_1, &wake, 1);
+    gpio_pin_mode(PIN_D13, GPIO_OUTPUT);
+    gpio_pin_mode(PIN_D2, GPIO_INPUT_PULLUP);
+
+    sched_init();
+    blink_task = sched_add(blink, NULL);
+    button_task = sched_add(button, NULL);
+    echo_task = sched_add(echo, NULL);
+    imu_start_task = sched_add(imu_start, NULL);
+    imu_done_task = sched_add(imu_done, NULL);
+
+    imu_xfer = (i2c_xfer_t){
+        .addr7 = IMU_ADDR,
+        .flags = I2C_XFER_READ,
+        .hdr = { IMU_ACCEL_XOUT },
+        .hdr_len = 1,
+        .rbuf = accel,
+        .rlen = sizeof(accel),
+        .callback = on_imu,
+        .status = I2C_OK
+    };
+
+    sched_every(blink_task, 500);
+    sched_every(imu_start_task, 100);
+    gpio_attach_interrupt(PIN_D2, GPIO_EDGE_FALLING, on_button);
+    uart0_set_rx_callback(on_rx);
+    sei();
+
+    sched_run(); // never returns
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include "spiMaster.h"
+#include "uart0_spi.h"
+#include "gpio.h"
+#include <avr/interrupt.h>
+#include <util/delay.h>
+
+// Example devices:
+//   - W25Qxx SPI flash, CS = D9  (mode 0, 8 MHz)
+//   - 74HC595 shift register chain, latch = D8 (mode 0, LSB first, 1 MHz)
+#define FLASH_CS      PIN_D9
+#define SR_LATCH      PIN_D8
+#define FLASH_JEDEC_ID 0x9F
+
+static spi_device_t flash;
+static spi_device_t shiftreg;
+
+// Example 1: Read the flash JEDEC ID at f_osc/2
+void example_flash_id(void) {
+    gpio_pin_mode(PIN_D7, GPIO_OUTPUT); // status LED
+
+    while (1) {
+        uint8_t cmd[4] = { FLASH_JEDEC_ID, 0xFF, 0xFF, 0xFF };
+        uint8_t id[4];
+
+        spi_select(&flash);
+        spi_transfer_buf(cmd, id, sizeof(cmd)); // id[1..3] = manufacturer, type, capacity
+        spi_deselect(&flash);
+
+        // Winbond = 0xEF
+        gpio_write(PIN_D7, id[1] == 0xEF ? GPIO_HIGH : GPIO_LOW);
+        _delay_ms(500);
+    }
+}
+
+// Example 2: Stream a pattern to the shift registers in the background
+static uint8_t pattern[4];
+
+static void shiftreg_done(void *user) {
+    (void)user;
+    // Latch the new outputs (CS doubles as the 595 latch)
+    gpio_write(SR_LATCH, GPIO_HIGH);
+}
+
+void example_shiftreg_async(void) {
+    uint8_t step = 0;
+
+    while (1) {
+        if (!spi_busy()) {
+            for (uint8_t i = 0; i < sizeof(pattern); i++) {
+                pattern[i] = (uint8_t)(1 << ((step + i) & 7));
+            }
+            spi_select(&shiftreg);
+            spi_transfer_async(pattern, NULL, sizeof(pattern), shiftreg_done, NULL);
+            step++;
+        }
+        _delay_ms(100); // ... other work
+    }
+}
+
+// Example 3: Second SPI bus on USART0 (MSPIM): 74HC595 chain on D1 (data) / D4 (clock),
+//            latch = D5. The double-buffered transmitter sends the 4 bytes back to back.
+void example_shiftreg_usart(void) {
+    static uart0_spi_device_t sr2;
+    const spi_config_t cfg = { SPI_MODE0, SPI_LSB_FIRST, SPI_CLK_DIV2 };
+
+    uart0_spi_init();
+    uart0_spi_device_init(&sr2, PIN_D5, &cfg);
+
+    uint8_t step = 0;
+    while (1) {
+        for (uint8_t i = 0; i < sizeof(pattern); i++) {
+            pattern[i] = (uint8_t)(0x80 >> ((step + i) & 7));
+        }
+        uart0_spi_select(&sr2);
+        uart0_spi_transfer_buf(pattern, NULL, sizeof(pattern)); // returns with the last bit out
+        uart0_spi_deselect(&sr2);                               // rising edge latches
+        step++;
+        _delay_ms(100);
+    }
+}
+
+int main(void) {
+    spi_init();
+
+    const spi_config_t flash_cfg = { SPI_MODE0, SPI_MSB_FIRST, SPI_CLK_DIV2 };
+    const spi_config_t sr_cfg = { SPI_MODE0, SPI_LSB_FIRST, SPI_CLK_DIV16 };
+    spi_device_init(&flash, FLASH_CS, &flash_cfg);
+    spi_device_init(&shiftreg, SR_LATCH, &sr_cfg);
+    sei();
+
+    // Choose one example to run:
+    example_flash_id();           // Example 1: JEDEC ID
+    // example_shiftreg_async();  // Example 2: background streaming
+    // example_shiftreg_usart();  // Example 3: USART0 as a second SPI bus
+
+    return 0;
+}
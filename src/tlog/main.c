@@ -0,0 +1,84 @@
+#include "tlog.h"
+#include "tlog_ids.h"
+#include "adc.h"
+#include "gpio_irq.h"
+#include "uart0.h"
+#include "timebase.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+// Binary event log: every record here is 11..16 bytes on the wire whatever it says,
+// formatted on the host:
+//   tools/tlog/tlog_decode /dev/ttyUSB0     (after: stty -F /dev/ttyUSB0 raw 115200)
+
+// ISR context: logging costs a cli() section and a few byte copies
+static void on_pin(gpio_pin_t pin, gpio_level_t level) {
+    TLOG2(TLOG_PIN, (uint8_t)pin, (uint8_t)level);
+}
+
+int main(void) {
+    uint8_t mcusr = MCUSR;
+    MCUSR = 0;
+
+    uart0_config_t cfg = {
+        .baud = 115200,
+        .databits = UART_DATABITS_8,
+        .parity = UART_PARITY_NONE,
+        .stopbits = UART_STOP_1,
+        .use_u2x = UART_U2X_AUTO
+    };
+    uart0_init(&cfg);
+    tlog_init();
+
+    adc_config_t acfg = {
+        .channels = (1 << 0),
+        .ref = ADC_REF_AVCC,
+        .trigger = ADC_TRIG_TIMER0_OVF,
+        .clkdiv = ADC_CLK_DIV128,
+        .oversample_bits = 3       // ~15 samples/s
+    };
+    adc_init(&acfg);
+
+    gpio_pin_mode(PIN_D2, GPIO_INPUT_PULLUP);
+    gpio_attach_interrupt(PIN_D2, GPIO_EDGE_CHANGE, on_pin);
+    sei();
+
+    TLOG1(TLOG_BOOT, mcusr);
+    adc_start();
+
+    uint32_t last = time_ms();
+    uint32_t t_loop = time_us();
+    uint16_t loop_max = 0;
+    uint16_t prev = 0;
+    uint32_t secs = 0;
+    uint16_t dropped = 0;
+    while (1) {
+        adc_sample_t s;
+        if (adc_read(&s, 1)) {
+            TLOG3(TLOG_ADC, s.channel, s.value, (int16_t)(s.value - prev));
+            prev = s.value;
+        }
+
+        if (time_ms() - last >= 1000) {
+            last += 1000;
+            TLOG2(TLOG_TICK, ++secs, loop_max);
+            loop_max = 0;
+
+            uint16_t d = tlog_dropped();
+            if (d != dropped) {
+                dropped = d;
+                TLOG1(TLOG_DROPPED, d);
+            }
+        }
+
+        // Drain: one frame per pass, only when it fits the UART0 TX ring
+        tlog_poll();
+
+        uint32_t now = time_us();
+        uint32_t dt = now - t_loop;
+        t_loop = now;
+        if (dt > loop_max)
+            loop_max = (dt > 0xFFFF) ? 0xFFFF : (uint16_t)dt;
+    }
+    return 0;
+}
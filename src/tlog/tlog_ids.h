@@ -0,0 +1,28 @@
+#ifndef TLOG_IDS_H
+#define TLOG_IDS_H
+
+// Log sites of the tlog demo, shared by the firmware (src/tlog/main.c) and the
+// host decoder (tools/tlog/tlog_decode.c). The format strings only exist on
+// the host: the firmware sends the id and the raw argument bytes.
+//
+// X(id, format, signature)
+//   signature: one letter per argument, in order, little endian on the wire
+//     b = uint8_t   h = uint16_t   w = uint32_t
+//     B = int8_t    H = int16_t    W = int32_t
+//   format: printf conversions without length modifiers (%u %d %x %c, with
+//   flags/width), one per argument. Arguments at the call site must have the
+//   signature's exact type (cast literals: TLOG1(TLOG_X, (uint8_t)3)).
+// Append new ids at the end: the numbers are the wire format.
+
+#define TLOG_LIST(X)                                                        \
+    X(TLOG_BOOT,     "boot, MCUSR=0x%02x",                   "b")           \
+    X(TLOG_TICK,     "tick %u s, loop max %u us",            "wh")          \
+    X(TLOG_ADC,      "A%u = %u (%+d)",                       "bhH")         \
+    X(TLOG_PIN,      "pin D%u -> %u",                        "bb")          \
+    X(TLOG_DROPPED,  "%u records dropped so far",            "h")
+
+#define TLOG_ENUM(id, fmt, sig) id,
+enum { TLOG_LIST(TLOG_ENUM) TLOG_COUNT };
+#undef TLOG_ENUM
+
+#endif
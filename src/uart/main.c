@@ -0,0 +1,143 @@
+#include "uart0.h"
+#include "uart0_frame.h"
+#include "hal_stats.h"
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+#define UART_TIMEOUT_US 100000UL // 100 ms per byte
+
+// Example 1: Echo using the non-blocking API (main loop never waits on the wire)
+void example_echo_nb(void) {
+    uint8_t buf[16];
+
+    while (1) {
+        size_t n = uart0_read_nb(buf, sizeof(buf));
+        if (n) {
+            uart0_write_nb(buf, n);
+        }
+        // ... other work here
+    }
+}
+
+// Example 2: Blocking line echo
+void example_echo_line(void) {
+    uint32_t errors = 0;
+    UART0_PRINTLN("uart0 ready", UART_TIMEOUT_US); // text stays in flash
+
+    while (1) {
+        uint8_t b;
+        uart_status_t st = uart0_read_byte(&b, UART_TIMEOUT_US);
+        if (st == UART_ERR_HW) {
+            UART0_PRINT("[rx error] count=", UART_TIMEOUT_US);
+            uart0_write_u32(++errors, UART_TIMEOUT_US);
+            uart0_write_line_P(UART0_STR(""), UART_TIMEOUT_US);
+        } else if (st == UART_OK) {
+            uart0_write_byte(b, UART_TIMEOUT_US);
+        }
+    }
+}
+
+#if UART0_FRAMING != UART0_FRAMING_NONE
+// Example 3: Whole-frame RX (build with -DUART0_FRAMING=UART0_FRAMING_COBS)
+static volatile uint8_t frames_pending;
+
+static void on_frame(void) {
+    frames_pending = 1; // ISR context: once per packet, not per byte
+}
+
+void example_frames(void) {
+    uart0_frame_set_callback(on_frame);
+    set_sleep_mode(SLEEP_MODE_IDLE);
+
+    while (1) {
+        uint8_t len;
+        const uint8_t *f;
+        frames_pending = 0; // before draining: a frame completing meanwhile sets it again
+        while ((f = uart0_frame_get(&len)) != NULL) {
+            uart0_write(f, len, UART_TIMEOUT_US); // echo the decoded payload in place
+            uart0_frame_release();
+        }
+
+        cli();
+        if (!frames_pending) {
+            sleep_enable();
+            sei();
+            sleep_cpu(); // woken by the next interrupt
+            sleep_disable();
+        }
+        sei();
+    }
+}
+#endif
+
+// Example 4: Echo plus a binary health record every 10 s (build with -DHAL_STATS=1)
+//            'H' 'S' len <hal_stats_t> sum: bytes, FE/DOR/UPE drops, ring high-water...
+void example_stats(void) {
+    uint8_t buf[16];
+    uint32_t last = time_ms();
+
+    while (1) {
+        size_t n = uart0_read_nb(buf, sizeof(buf));
+        if (n) {
+            uart0_write_nb(buf, n);
+        }
+        if (time_ms() - last >= 10000) {
+            last += 10000;
+            hal_stats_dump(true, UART_TIMEOUT_US); // snapshot and start a new window
+        }
+    }
+}
+
+#if UART0_9BIT && UART0_RS485
+// Example 5: RS-485 node 0x12 (build with -DUART0_9BIT=1 -DUART0_RS485=1, UART_DATABITS_9)
+//            Traffic for other nodes never interrupts us; each message addressed to us
+//            is answered with its length, DE on D2 is switched by the driver.
+//            Broadcasts are received but never answered: every node would reply at once.
+#define NODE_ADDR 0x12
+#define NODE_BCAST 0xFF
+
+void example_rs485(void) {
+    uart0_rs485_enable(PIN_D2, true);
+    uart0_mpcm_enable(NODE_ADDR, NODE_BCAST);
+
+    uint8_t len = 0;
+    bool to_us = false;             // message opened by NODE_ADDR, not by the broadcast
+    while (1) {
+        uint16_t w;
+        if (uart0_read9(&w, UART_TIMEOUT_US) == UART_OK) {
+            if (w & 0x100) {
+                len = 0;            // our (or the broadcast) address: new message
+                to_us = ((uint8_t)w == NODE_ADDR);
+            } else {
+                len++;
+            }
+        } else if (len && to_us && uart0_mpcm_addressed()) {
+            // Line quiet after a message to us: reply to the master (address 0)
+            uart0_write_address(0x00, UART_TIMEOUT_US);
+            uart0_write9(len, UART_TIMEOUT_US);
+            len = 0;
+        }
+    }
+}
+#endif
+
+int main(void) {
+    uart0_config_t cfg = {
+        .baud = 115200,
+        .databits = UART_DATABITS_8,
+        .parity = UART_PARITY_NONE,
+        .stopbits = UART_STOP_1,
+        .use_u2x = UART_U2X_AUTO
+    };
+    uart0_init(&cfg);
+    sei(); // RX/TX are interrupt-driven
+
+    // Choose one example to run:
+    example_echo_nb();      // Example 1: non-blocking echo
+    // example_echo_line(); // Example 2: blocking echo
+    // example_frames();    // Example 3: framed RX (needs UART0_FRAMING)
+    // example_stats();     // Example 4: health counters (needs HAL_STATS)
+    // example_rs485();     // Example 5: addressed RS-485 node (needs UART0_9BIT, UART0_RS485)
+
+    return 0;
+}
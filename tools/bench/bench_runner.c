@@ -0,0 +1,176 @@
+// Host-side benchmark runner: loads the bench firmware into simavr, plays a
+// TWI slave, and prints one JSON object per benchmark on stdout.
+//
+//   bench_runner <firmware.elf>
+//
+// Cycle counts come from the simulator (avr->cycle) at the GPIOR0/GPIOR1
+// marker writes, see src/bench/bench_ids.h.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <simavr/sim_avr.h>
+#include <simavr/sim_elf.h>
+#include <simavr/sim_io.h>
+#include <simavr/avr_twi.h>
+#include <simavr/avr_uart.h>
+
+#include "../../src/bench/bench_ids.h"
+
+#define IO_GPIOR0 0x3E   // data-space addresses
+#define IO_GPIOR1 0x4A
+#define IO_GPIOR2 0x4B
+
+#define BENCH_MAX_CYCLES (16000000ULL * 10) // 10 s of simulated time
+
+typedef struct {
+    const char *name;
+    unsigned ops;
+    avr_cycle_count_t start;
+    avr_cycle_count_t cycles;
+    uint8_t status;
+    int done;
+} bench_result_t;
+
+#define BENCH_ROW(id, name, ops) { name, ops, 0, 0, 0, 0 },
+static bench_result_t results[BENCH_COUNT] = { BENCH_LIST(BENCH_ROW) };
+#undef BENCH_ROW
+
+// ---------- Markers ----------
+static void marker_begin(struct avr_t *avr, avr_io_addr_t addr, uint8_t v, void *param)
+{
+    (void)param;
+    avr->data[addr] = v;
+    if (v < BENCH_COUNT)
+        results[v].start = avr->cycle;
+}
+
+static void marker_end(struct avr_t *avr, avr_io_addr_t addr, uint8_t v, void *param)
+{
+    (void)param;
+    avr->data[addr] = v;
+    if (v < BENCH_COUNT) {
+        results[v].cycles = avr->cycle - results[v].start;
+        results[v].status = avr->data[IO_GPIOR2];
+        results[v].done = 1;
+    }
+}
+
+// ---------- Simulated TWI slave: 256-byte register file ----------
+typedef struct {
+    avr_irq_t *irq;     // [TWI_IRQ_INPUT, TWI_IRQ_OUTPUT]
+    uint8_t selected;   // SLA byte while addressed, 0 otherwise
+    uint8_t index;      // bytes written since START
+    uint8_t reg;
+    uint8_t regs[256];
+} twi_slave_t;
+
+static void twi_slave_hook(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+    (void)irq;
+    twi_slave_t *s = (twi_slave_t *)param;
+    avr_twi_msg_irq_t v;
+    v.u.v = value;
+
+    if (v.u.twi.msg & TWI_COND_STOP) {
+        s->selected = 0;
+        s->index = 0;
+    }
+    if (v.u.twi.msg & TWI_COND_START) {
+        s->selected = 0;
+        s->index = 0;
+        if ((v.u.twi.addr >> 1) == BENCH_I2C_ADDR) {
+            s->selected = v.u.twi.addr;
+            avr_raise_irq(s->irq + TWI_IRQ_INPUT, avr_twi_irq_msg(TWI_COND_ACK, s->selected, 1));
+        }
+    }
+    if (!s->selected)
+        return;
+
+    if (v.u.twi.msg & TWI_COND_WRITE) {
+        avr_raise_irq(s->irq + TWI_IRQ_INPUT, avr_twi_irq_msg(TWI_COND_ACK, s->selected, 1));
+        if (s->index++ == 0)
+            s->reg = v.u.twi.data;          // first byte = register pointer
+        else
+            s->regs[s->reg++] = v.u.twi.data;
+    }
+    if (v.u.twi.msg & TWI_COND_READ) {
+        avr_raise_irq(s->irq + TWI_IRQ_INPUT,
+                      avr_twi_irq_msg(TWI_COND_READ, s->selected, s->regs[s->reg++]));
+    }
+}
+
+static const char *twi_slave_irq_names[2] = { "8<twi.slave.in", "32>twi.slave.out" };
+
+static void twi_slave_attach(avr_t *avr, twi_slave_t *s)
+{
+    memset(s, 0, sizeof(*s));
+    for (int i = 0; i < 256; i++)
+        s->regs[i] = (uint8_t)i;
+
+    s->irq = avr_alloc_irq(&avr->irq_pool, 0, 2, twi_slave_irq_names);
+    avr_irq_register_notify(s->irq + TWI_IRQ_OUTPUT, twi_slave_hook, s);
+    avr_connect_irq(s->irq + TWI_IRQ_INPUT, avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_INPUT));
+    avr_connect_irq(avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_OUTPUT), s->irq + TWI_IRQ_OUTPUT);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <firmware.elf>\n", argv[0]);
+        return 2;
+    }
+
+    elf_firmware_t fw;
+    memset(&fw, 0, sizeof(fw));
+    if (elf_read_firmware(argv[1], &fw) != 0) {
+        fprintf(stderr, "bench_runner: cannot read %s\n", argv[1]);
+        return 2;
+    }
+    strcpy(fw.mmcu, "atmega328p");
+    fw.frequency = 16000000;
+
+    avr_t *avr = avr_make_mcu_by_name(fw.mmcu);
+    if (!avr) {
+        fprintf(stderr, "bench_runner: simavr has no atmega328p core\n");
+        return 2;
+    }
+    avr_init(avr);
+    avr_load_firmware(avr, &fw);
+    avr->log = LOG_WARNING;
+
+    // Keep the firmware's UART traffic off our stdout
+    uint32_t uart_flags = 0;
+    avr_ioctl(avr, AVR_IOCTL_UART_GET_FLAGS('0'), &uart_flags);
+    uart_flags &= ~AVR_UART_FLAG_STDIO;
+    avr_ioctl(avr, AVR_IOCTL_UART_SET_FLAGS('0'), &uart_flags);
+
+    avr_register_io_write(avr, IO_GPIOR0, marker_begin, NULL);
+    avr_register_io_write(avr, IO_GPIOR1, marker_end, NULL);
+
+    static twi_slave_t slave;
+    twi_slave_attach(avr, &slave);
+
+    int state = cpu_Running;
+    while (state != cpu_Done && state != cpu_Crashed && avr->cycle < BENCH_MAX_CYCLES)
+        state = avr_run(avr);
+
+    avr_cycle_count_t overhead = results[BENCH_OVERHEAD].done ? results[BENCH_OVERHEAD].cycles : 0;
+    int failed = (state == cpu_Crashed);
+
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        bench_result_t *r = &results[i];
+        if (!r->done) {
+            printf("{\"bench\":\"%s\",\"error\":\"not reached\"}\n", r->name);
+            failed = 1;
+            continue;
+        }
+        unsigned long long net = (i == BENCH_OVERHEAD || r->cycles < overhead)
+                                     ? r->cycles : r->cycles - overhead;
+        printf("{\"bench\":\"%s\",\"cycles\":%llu,\"ops\":%u,\"cycles_per_op\":%.1f,\"status\":%u}\n",
+               r->name, net, r->ops, (double)net / r->ops, r->status);
+        if (r->status)
+            failed = 1;
+    }
+    return failed;
+}
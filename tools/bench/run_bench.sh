@@ -0,0 +1,37 @@
+#!/bin/sh
+# Build the bench firmware and the simavr runner, run it, and print JSON lines:
+#   {"bench":...,"cycles":...}   cycle counts per driver hot path
+#   {"footprint":...}            flash/SRAM of the firmware and per-function sizes
+# Usage: tools/bench/run_bench.sh [path/to/firmware.elf]
+set -e
+
+ROOT=$(cd "$(dirname "$0")/../.." && pwd)
+ELF=${1:-$ROOT/.pio/build/bench/firmware.elf}
+SIZE=${AVR_SIZE:-avr-size}
+NM=${AVR_NM:-avr-nm}
+
+if [ -z "$1" ]; then
+    (cd "$ROOT" && pio run -e bench) >&2
+fi
+make -s -C "$ROOT/tools/bench" bench_runner >&2
+
+"$ROOT/tools/bench/bench_runner" "$ELF" || status=$?
+
+# Whole image: text+data in flash, data+bss in SRAM
+$SIZE -A "$ELF" | awk '
+    $1 == ".text" { text = $2 } $1 == ".data" { data = $2 } $1 == ".bss" { bss = $2 }
+    END { printf "{\"footprint\":\"image\",\"flash\":%d,\"sram\":%d}\n", text + data, data + bss }'
+
+# Hot-path functions (symbol sizes in bytes); vectors: 18/19 = USART RX/UDRE, 24 = TWI
+FNS="gpio_write gpio_read gpio_toggle gpio_group_write uart0_calc_ubrr uart0_write
+     uart0_write_nb uart0_write_byte i2c_read_reg __vector_18 __vector_19 __vector_24"
+$NM -S --defined-only "$ELF" | while read -r addr size type name; do
+    [ -n "$name" ] || continue
+    for fn in $FNS; do
+        if [ "$name" = "$fn" ]; then
+            printf '{"footprint":"%s","flash":%d}\n' "$name" "0x$size"
+        fi
+    done
+done
+
+exit ${status:-0}
@@ -0,0 +1,185 @@
+// Host-side decoder for the binary event log (lib/tlog_hal): splits the byte
+// stream on 0x00, COBS-decodes and CRC-checks each frame, and prints it with
+// the format string of its id.
+//
+//   tlog_decode [capture.bin | /dev/ttyUSB0]    (stdin without argument)
+//
+// A serial port must already be raw at the right baud rate, e.g.
+//   stty -F /dev/ttyUSB0 raw 115200
+// The id table is compiled in: build with TLOG_IDS=<path to the ids header>
+// (default: the demo's src/tlog/tlog_ids.h).
+//
+// Output, one line per record:
+//   <seconds.micros> #<seq> <formatted text>
+// plus "# lost N" lines on sequence gaps and a summary on stderr.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef TLOG_IDS
+#define TLOG_IDS "../../src/tlog/tlog_ids.h"
+#endif
+#include TLOG_IDS
+
+#define FRAME_MAX 64    // longer garbage between delimiters is skipped
+#define ARGS_MAX  8
+
+typedef struct {
+    const char *name;
+    const char *fmt;
+    const char *sig;
+} tlog_site_t;
+
+#define TLOG_ROW(id, fmt, sig) { #id, fmt, sig },
+static const tlog_site_t sites[TLOG_COUNT] = { TLOG_LIST(TLOG_ROW) };
+#undef TLOG_ROW
+
+static unsigned long n_frames, n_crc, n_malformed, n_lost;
+
+static uint16_t crc_xmodem(const uint8_t *p, size_t n)
+{
+    uint16_t crc = 0;
+    while (n--) {
+        crc ^= (uint16_t)(*p++ << 8);
+        for (int i = 0; i < 8; i++)
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+// Returns the decoded length, or 0 for a malformed frame
+static size_t cobs_decode(const uint8_t *in, size_t n, uint8_t *out)
+{
+    size_t i = 0, o = 0;
+    while (i < n) {
+        uint8_t code = in[i++];
+        if (code == 0 || i + code - 1 > n)
+            return 0;
+        for (uint8_t k = 1; k < code; k++)
+            out[o++] = in[i++];
+        if (code != 0xFF && i < n)
+            out[o++] = 0;
+    }
+    return o;
+}
+
+// Decode the arguments per signature; -1 when the sizes disagree
+static int decode_args(const char *sig, const uint8_t *p, size_t len, unsigned v[ARGS_MAX])
+{
+    size_t off = 0;
+    int n = 0;
+    for (; *sig; sig++, n++) {
+        if (n == ARGS_MAX)
+            return -1;
+        size_t w = (*sig == 'b' || *sig == 'B') ? 1 : (*sig == 'h' || *sig == 'H') ? 2 : 4;
+        if (off + w > len)
+            return -1;
+        uint32_t x = 0;
+        for (size_t k = 0; k < w; k++)
+            x |= (uint32_t)p[off + k] << (8 * k);
+        off += w;
+        switch (*sig) {
+        case 'b': case 'h': case 'w': v[n] = x; break;
+        case 'B': v[n] = (unsigned)(int)(int8_t)x; break;
+        case 'H': v[n] = (unsigned)(int)(int16_t)x; break;
+        case 'W': v[n] = (unsigned)(int)(int32_t)x; break;
+        default: return -1;
+        }
+    }
+    return off == len ? n : -1;
+}
+
+static void print_record(const uint8_t *f, size_t len)
+{
+    static int have_seq;
+    static uint8_t next_seq;
+
+    uint8_t seq = f[0];
+    uint8_t id = f[1];
+    uint32_t t = (uint32_t)f[2] | (uint32_t)f[3] << 8 | (uint32_t)f[4] << 16 | (uint32_t)f[5] << 24;
+    const uint8_t *args = f + 6;
+    size_t n_args = len - 6;
+
+    if (have_seq && seq != next_seq) {
+        unsigned lost = (uint8_t)(seq - next_seq);
+        n_lost += lost;
+        printf("# lost %u\n", lost);
+    }
+    have_seq = 1;
+    next_seq = (uint8_t)(seq + 1);
+
+    printf("%lu.%06lu #%u ", (unsigned long)(t / 1000000), (unsigned long)(t % 1000000), seq);
+
+    unsigned v[ARGS_MAX] = { 0 };
+    if (id < TLOG_COUNT && decode_args(sites[id].sig, args, n_args, v) >= 0) {
+        printf(sites[id].fmt, v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]);
+        putchar('\n');
+        return;
+    }
+
+    // Unknown id or a table that does not match the firmware: raw bytes
+    printf("id %u:", id);
+    for (size_t i = 0; i < n_args; i++)
+        printf(" %02x", args[i]);
+    printf(id < TLOG_COUNT ? " (%s: size mismatch)\n" : " (unknown id)\n",
+           id < TLOG_COUNT ? sites[id].name : "");
+}
+
+static void handle_frame(const uint8_t *in, size_t n)
+{
+    uint8_t f[FRAME_MAX];
+    if (n == 0)
+        return;
+    n_frames++;
+
+    size_t len = cobs_decode(in, n, f);
+    if (len < 8) { // seq, id, t_us, CRC
+        n_malformed++;
+        return;
+    }
+    if (crc_xmodem(f, len) != 0) { // CRC appended big endian: residue 0
+        n_crc++;
+        return;
+    }
+    print_record(f, len - 2);
+}
+
+int main(int argc, char **argv)
+{
+    FILE *in = stdin;
+    if (argc > 2) {
+        fprintf(stderr, "usage: %s [capture.bin | tty]\n", argv[0]);
+        return 2;
+    }
+    if (argc == 2 && !(in = fopen(argv[1], "rb"))) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    uint8_t buf[FRAME_MAX];
+    size_t n = 0;
+    int overflow = 0;
+    int c;
+    while ((c = getc(in)) != EOF) {
+        if (c == 0) {
+            if (overflow)
+                n_malformed++;
+            else
+                handle_frame(buf, n);
+            n = 0;
+            overflow = 0;
+            fflush(stdout); // live output from a tty
+        } else if (n < sizeof(buf)) {
+            buf[n++] = (uint8_t)c;
+        } else {
+            overflow = 1;
+        }
+    }
+
+    fprintf(stderr, "%lu frames, %lu bad CRC, %lu malformed, %lu records lost\n",
+            n_frames, n_crc, n_malformed, n_lost);
+    if (in != stdin)
+        fclose(in);
+    return 0;
+}